@@ -929,7 +929,7 @@
   #undef AUTO_REPORT_TEMPERATURES
 #endif
 
-#define HAS_AUTO_REPORTING (ENABLED(AUTO_REPORT_TEMPERATURES) || ENABLED(AUTO_REPORT_SD_STATUS))
+#define HAS_AUTO_REPORTING (ENABLED(AUTO_REPORT_TEMPERATURES) || ENABLED(AUTO_REPORT_SD_STATUS) || ENABLED(PROFILE_HOT_PATHS))
 
 /**
  * This setting is also used by M109 when trying to calculate
@@ -1108,6 +1108,14 @@
 #define HAS_PROBING_PROCEDURE (HAS_ABL || ENABLED(Z_MIN_PROBE_REPEATABILITY_TEST))
 #define HAS_UBL_AND_CURVES (ENABLED(AUTO_BED_LEVELING_UBL) && !PLANNER_LEVELING && (ENABLED(ARC_SUPPORT) || ENABLED(BEZIER_CURVE_SUPPORT)))
 #define HAS_FEEDRATE_SCALING (ENABLED(SCARA_FEEDRATE_SCALING) || ENABLED(DELTA_FEEDRATE_SCALING))
+#define HAS_PACKED_COMMANDS (ENABLED(BINARY_GCODE_PROTOCOL) || ENABLED(PARSED_COMMAND_QUEUE))
+
+#if ENABLED(COMMAND_ARENA)
+  #define COMMAND_SLOTS COMMAND_ARENA_SLOTS
+  #define COMMAND_ARENA_SIZE ((BUFSIZE) * (MAX_CMD_SIZE))
+#else
+  #define COMMAND_SLOTS BUFSIZE
+#endif
 
 #if ENABLED(AUTO_BED_LEVELING_UBL)
   #undef LCD_BED_LEVELING
@@ -23,6 +23,10 @@
  * Description: HAL for __AVR__
  */
 
+#ifdef __PLAT_LINUX__
+  #include "HAL_LINUX/HAL_LINUX.h"
+#else
+
 #ifndef _HAL_AVR_H_
 #define _HAL_AVR_H_
 
@@ -84,6 +88,9 @@ typedef int8_t pin_t;
 inline void HAL_clear_reset_source(void) { MCUSR = 0; }
 inline uint8_t HAL_get_reset_source(void) { return MCUSR; }
 
+// Timestamp for profiling, in µs (4µs resolution at 16MHz)
+#define HAL_profile_us() micros()
+
 // eeprom
 //void eeprom_write_byte(unsigned char *pos, unsigned char value);
 //unsigned char eeprom_read_byte(unsigned char *pos);
@@ -335,3 +342,5 @@ inline void HAL_adc_init(void) {
 #define HAL_SENSITIVE_PINS 0, 1
 
 #endif // _HAL_AVR_H_
+
+#endif // !__PLAT_LINUX__
@@ -0,0 +1,117 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Minimal Arduino core for the host simulator (__PLAT_LINUX__).
+ * Only what Marlin uses is provided. Time is simulated, see HAL_LINUX/sim.h.
+ */
+
+#ifndef _HAL_LINUX_ARDUINO_H_
+#define _HAL_LINUX_ARDUINO_H_
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include <avr/interrupt.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT        0x0
+#define OUTPUT       0x1
+#define INPUT_PULLUP 0x2
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+#define BYTE 0
+
+#define PI         3.1415926535897932384626433832795
+#define HALF_PI    1.5707963267948966192313216916398
+#define TWO_PI     6.283185307179586476925286766559
+#define DEG_TO_RAD 0.017453292519943295769236907684886
+#define RAD_TO_DEG 57.295779513082320876798154814105
+
+#define sq(x) ((x)*(x))
+#define constrain(amt,low,high) ((amt)<(low)?(low):((amt)>(high)?(high):(amt)))
+#define lowByte(w) ((uint8_t) ((w) & 0xFF))
+#define highByte(w) ((uint8_t) ((w) >> 8))
+#define bit(b) (1UL << (b))
+
+#define NOT_A_PIN 0
+#define NOT_AN_INTERRUPT -1
+#define digitalPinToInterrupt(p) NOT_AN_INTERRUPT
+#define digitalPinToPCICR(p) ((uint8_t *)0)
+#define analogInputToDigitalPin(p) ((p) + 54)
+
+// Time, in simulated microcontroller time
+uint32_t millis();
+uint32_t micros();
+void delay(const uint32_t ms);
+void delayMicroseconds(const uint32_t us);
+
+// Pins, routed through the simulated ports
+void pinMode(const uint8_t pin, const uint8_t mode);
+void digitalWrite(const uint8_t pin, const uint8_t val);
+int digitalRead(const uint8_t pin);
+void analogWrite(const uint8_t pin, const int val);
+int analogRead(const uint8_t pin);
+
+void attachInterrupt(const uint8_t irq, void (*fn)(), const int mode);
+void detachInterrupt(const uint8_t irq);
+#define CHANGE  1
+#define FALLING 2
+#define RISING  3
+
+char* itoa(int value, char *str, int base);
+char* ltoa(long value, char *str, int base);
+char* ultoa(unsigned long value, char *str, int base);
+char* dtostrf(double val, signed char width, unsigned char prec, char *sout);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+class __FlashStringHelper;
+#define F(S) (reinterpret_cast<const __FlashStringHelper *>(PSTR(S)))
+
+// Just enough of Arduino's String for MarlinSerial::print(const String&)
+class String {
+  public:
+    String(const char *s = "") : str(s) {}
+    unsigned int length() const { return strlen(str); }
+    char operator[](unsigned int i) const { return str[i]; }
+  private:
+    const char *str;
+};
+
+#endif // _HAL_LINUX_ARDUINO_H_
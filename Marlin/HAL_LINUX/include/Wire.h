@@ -0,0 +1,62 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * I2C master for the host simulator
+ *
+ * Every slave acknowledges and reads return zeros, so code talking to
+ * Mechaduinos or I2C encoders runs without hardware attached.
+ */
+
+#ifndef _HAL_LINUX_WIRE_H_
+#define _HAL_LINUX_WIRE_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define BUFFER_LENGTH 32
+
+class TwoWire {
+  public:
+    void begin() {}
+    void begin(const uint8_t) {}
+    void begin(const int) {}
+    void setClock(const uint32_t) {}
+    void beginTransmission(const uint8_t) {}
+    void beginTransmission(const int a) { beginTransmission((uint8_t)a); }
+    uint8_t endTransmission(const bool=true) { return 0; }
+    uint8_t requestFrom(const uint8_t, const uint8_t quantity) { rx_remaining = quantity > BUFFER_LENGTH ? BUFFER_LENGTH : quantity; return rx_remaining; }
+    uint8_t requestFrom(const int a, const int quantity) { return requestFrom((uint8_t)a, (uint8_t)quantity); }
+    size_t write(const uint8_t) { return 1; }
+    size_t write(const uint8_t *, const size_t n) { return n; }
+    size_t write(const char *data, const size_t n) { return write((const uint8_t*)data, n); }
+    int available() { return rx_remaining; }
+    int read() { if (!rx_remaining) return -1; rx_remaining--; return 0; }
+    int peek() { return rx_remaining ? 0 : -1; }
+    void onReceive(void (*)(int)) {}
+    void onRequest(void (*)(void)) {}
+  private:
+    uint8_t rx_remaining = 0;
+};
+
+extern TwoWire Wire;
+
+#endif // _HAL_LINUX_WIRE_H_
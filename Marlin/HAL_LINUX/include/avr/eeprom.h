@@ -0,0 +1,41 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Simulated EEPROM, an in-memory image of E2END + 1 bytes
+ */
+
+#ifndef _HAL_LINUX_EEPROM_H_
+#define _HAL_LINUX_EEPROM_H_
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define E2END 0xFFF
+
+uint8_t eeprom_read_byte(const uint8_t *pos);
+void eeprom_write_byte(uint8_t *pos, const uint8_t value);
+void eeprom_update_byte(uint8_t *pos, const uint8_t value);
+void eeprom_read_block(void *dst, const void *src, size_t n);
+void eeprom_update_block(const void *src, void *dst, size_t n);
+
+#endif // _HAL_LINUX_EEPROM_H_
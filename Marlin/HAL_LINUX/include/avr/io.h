@@ -0,0 +1,217 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Register file of the simulated ATmega2560
+ *
+ * Output ports are objects so the simulator can timestamp every pin change.
+ * Writing ones to a PINx register toggles the port, like the real part.
+ * Everything else is plain memory, read and written by the firmware only.
+ */
+
+#ifndef _HAL_LINUX_IO_H_
+#define _HAL_LINUX_IO_H_
+
+#include <stdint.h>
+
+#ifndef _BV
+  #define _BV(b) (1 << (b))
+#endif
+
+// Called by the simulator on every output port change (HAL_LINUX/sim_hardware.cpp)
+void sim_port_changed(const uint8_t port, const uint8_t old_value, const uint8_t new_value);
+
+class SimPortRegister {
+  public:
+    explicit SimPortRegister(const uint8_t p) : port(p), value(0) {}
+    operator uint8_t() const { return value; }
+    SimPortRegister& operator=(const uint8_t v) {
+      const uint8_t old_value = value;
+      value = v;
+      if (old_value != v) sim_port_changed(port, old_value, v);
+      return *this;
+    }
+    SimPortRegister& operator=(const SimPortRegister &r) { return *this = r.value; }
+    SimPortRegister& operator|=(const int v) { return *this = uint8_t(value | v); }
+    SimPortRegister& operator&=(const int v) { return *this = uint8_t(value & v); }
+    SimPortRegister& operator^=(const int v) { return *this = uint8_t(value ^ v); }
+    const uint8_t port;
+    uint8_t value;
+};
+
+class SimPinRegister {
+  public:
+    explicit SimPinRegister(SimPortRegister &p) : port(p) {}
+    operator uint8_t() const { return port.value; }
+    SimPinRegister& operator=(const int v) { port ^= v; return *this; }
+    SimPinRegister& operator|=(const int v) { port ^= v; return *this; }
+    SimPinRegister& operator&=(const int v) { port ^= ~v; return *this; }
+    SimPortRegister &port;
+};
+
+#define _SIM_PORT(P) extern SimPortRegister PORT##P; extern SimPinRegister PIN##P; extern volatile uint8_t DDR##P
+_SIM_PORT(A); _SIM_PORT(B); _SIM_PORT(C); _SIM_PORT(D); _SIM_PORT(E); _SIM_PORT(F);
+_SIM_PORT(G); _SIM_PORT(H); _SIM_PORT(J); _SIM_PORT(K); _SIM_PORT(L);
+#undef _SIM_PORT
+
+#define _SIM_PORT_BITS(P) \
+  P##0 = 0, P##1 = 1, P##2 = 2, P##3 = 3, P##4 = 4, P##5 = 5, P##6 = 6, P##7 = 7
+enum : uint8_t { _SIM_PORT_BITS(PINA) };
+enum : uint8_t { _SIM_PORT_BITS(PINB) };
+enum : uint8_t { _SIM_PORT_BITS(PINC) };
+enum : uint8_t { _SIM_PORT_BITS(PIND) };
+enum : uint8_t { _SIM_PORT_BITS(PINE) };
+enum : uint8_t { _SIM_PORT_BITS(PINF) };
+enum : uint8_t { _SIM_PORT_BITS(PING) };
+enum : uint8_t { _SIM_PORT_BITS(PINH) };
+enum : uint8_t { _SIM_PORT_BITS(PINJ) };
+enum : uint8_t { _SIM_PORT_BITS(PINK) };
+enum : uint8_t { _SIM_PORT_BITS(PINL) };
+#undef _SIM_PORT_BITS
+
+// Status register
+extern volatile uint8_t SREG, MCUSR;
+#define SREG_I 7
+#define PORF  0
+#define EXTRF 1
+#define BORF  2
+#define WDRF  3
+
+// Timers. Counters and compare registers of the stepper and temperature
+// timers are emulated by the HAL, these only hold configuration.
+#define _SIM_TIMER8(T)  extern volatile uint8_t TCCR##T##A, TCCR##T##B, TIMSK##T, TIFR##T, TCNT##T, OCR##T##A, OCR##T##B
+#define _SIM_TIMER16(T) extern volatile uint8_t TCCR##T##A, TCCR##T##B, TCCR##T##C, TIMSK##T, TIFR##T; \
+                        extern volatile uint16_t TCNT##T, OCR##T##A, OCR##T##B, OCR##T##C, ICR##T
+_SIM_TIMER8(0); _SIM_TIMER8(2);
+_SIM_TIMER16(1); _SIM_TIMER16(3); _SIM_TIMER16(4); _SIM_TIMER16(5);
+#undef _SIM_TIMER8
+#undef _SIM_TIMER16
+
+// Let feature tests (#ifdef TCCR2A, etc.) see the registers
+#define TCCR0A TCCR0A
+#define TCCR1A TCCR1A
+#define TCCR2A TCCR2A
+#define TCCR3A TCCR3A
+#define TCCR4A TCCR4A
+#define TCCR5A TCCR5A
+
+#define OCR0AL OCR0A
+#define OCR2AL OCR2A
+#define OCR1AL OCR1A
+#define OCR1BL OCR1B
+#define OCR3AL OCR3A
+#define OCR3BL OCR3B
+#define OCR3CL OCR3C
+#define OCR4AL OCR4A
+#define OCR4BL OCR4B
+#define OCR4CL OCR4C
+#define OCR5AL OCR5A
+#define OCR5BL OCR5B
+#define OCR5CL OCR5C
+
+#define _SIM_TIMER_BITS(T) \
+  WGM##T##0 = 0, WGM##T##1 = 1, WGM##T##2 = 3, WGM##T##3 = 4, \
+  COM##T##C0 = 2, COM##T##C1 = 3, COM##T##B0 = 4, COM##T##B1 = 5, COM##T##A0 = 6, COM##T##A1 = 7, \
+  CS##T##0 = 0, CS##T##1 = 1, CS##T##2 = 2, ICES##T = 6, ICNC##T = 7, \
+  FOC##T##C = 5, FOC##T##B = 6, FOC##T##A = 7, \
+  TOIE##T = 0, OCIE##T##A = 1, OCIE##T##B = 2, OCIE##T##C = 3, ICIE##T = 5
+enum : uint8_t { _SIM_TIMER_BITS(0) };
+enum : uint8_t { _SIM_TIMER_BITS(1) };
+enum : uint8_t { _SIM_TIMER_BITS(2) };
+enum : uint8_t { _SIM_TIMER_BITS(3) };
+enum : uint8_t { _SIM_TIMER_BITS(4) };
+enum : uint8_t { _SIM_TIMER_BITS(5) };
+#undef _SIM_TIMER_BITS
+
+// Pin change and external interrupts
+extern volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2, EICRA, EICRB, EIMSK, EIFR;
+
+// ADC configuration (conversions are emulated by the HAL)
+extern volatile uint8_t ADCSRA, ADCSRB, ADMUX, DIDR0, DIDR2;
+enum : uint8_t { ADPS0 = 0, ADPS1, ADPS2, ADIE, ADIF, ADATE, ADSC, ADEN };
+enum : uint8_t { MUX5 = 3, REFS0 = 6, REFS1 = 7 };
+#define DIDR2 DIDR2
+#define MUX5 MUX5
+
+// Power reduction
+extern volatile uint8_t PRR0, PRR1;
+#define PRR0 PRR0
+
+// SPI
+extern volatile uint8_t SPCR, SPSR, SPDR;
+enum : uint8_t { SPR0 = 0, SPR1, CPHA, CPOL, MSTR, DORD, SPE, SPIE };
+enum : uint8_t { SPI2X = 0, WCOL = 6, SPIF = 7 };
+
+// TWI. Writing the control register starts the next bus event.
+void sim_twi_control(const uint8_t v);
+
+class SimTwiControl {
+  public:
+    SimTwiControl() : value(0) {}
+    operator uint8_t() const { return value; }
+    SimTwiControl& operator=(const uint8_t v) { value = v; sim_twi_control(v); return *this; }
+    SimTwiControl& operator|=(const int v) { return *this = uint8_t(value | v); }
+    SimTwiControl& operator&=(const int v) { return *this = uint8_t(value & v); }
+    uint8_t value;
+};
+
+extern volatile uint8_t TWBR, TWSR, TWDR, TWAR;
+extern SimTwiControl TWCR;
+enum : uint8_t { TWIE = 0, TWEN = 2, TWWC, TWSTO, TWSTA, TWEA, TWINT };
+enum : uint8_t { TWPS0 = 0, TWPS1 };
+
+// USARTs. Data registers are objects so host traffic can be simulated.
+void sim_uart_tx(const uint8_t port, const uint8_t c);
+uint8_t sim_uart_rx(const uint8_t port);
+
+class SimUartData {
+  public:
+    explicit SimUartData(const uint8_t p) : port(p) {}
+    operator uint8_t() const { return sim_uart_rx(port); }
+    SimUartData& operator=(const uint8_t c) { sim_uart_tx(port, c); return *this; }
+    const uint8_t port;
+};
+
+// Transmission takes no time, so the data register always reads as empty
+class SimUartStatus {
+  public:
+    explicit SimUartStatus(const uint8_t m) : value(0), always_set(m) {}
+    operator uint8_t() const { return value | always_set; }
+    SimUartStatus& operator=(const int v) { value = v; return *this; }
+    SimUartStatus& operator|=(const int v) { value |= v; return *this; }
+    SimUartStatus& operator&=(const int v) { value &= v; return *this; }
+    uint8_t value;
+    const uint8_t always_set;
+};
+
+#define _SIM_UART(N) extern SimUartData UDR##N; extern SimUartStatus UCSR##N##A; extern volatile uint8_t UCSR##N##B, UCSR##N##C, UBRR##N##H, UBRR##N##L; \
+  enum : uint8_t { MPCM##N = 0, U2X##N, UPE##N, DOR##N, FE##N, UDRE##N, TXC##N, RXC##N }; \
+  enum : uint8_t { TXB8##N = 0, RXB8##N, UCSZ##N##2, TXEN##N, RXEN##N, UDRIE##N, TXCIE##N, RXCIE##N }
+_SIM_UART(0); _SIM_UART(1); _SIM_UART(2); _SIM_UART(3);
+#undef _SIM_UART
+#define UDR0 UDR0
+#define UBRR0H UBRR0H
+#define UBRR1H UBRR1H
+#define UBRR2H UBRR2H
+#define UBRR3H UBRR3H
+
+#endif // _HAL_LINUX_IO_H_
@@ -0,0 +1,43 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+/**
+ * Arduino Mega pin variant, as far as Marlin needs it
+ */
+
+#ifndef _HAL_LINUX_PINS_ARDUINO_H_
+#define _HAL_LINUX_PINS_ARDUINO_H_
+
+#define NUM_DIGITAL_PINS 70
+#define NUM_ANALOG_INPUTS 16
+
+#define PIN_WIRE_SDA 20
+#define PIN_WIRE_SCL 21
+
+enum {
+  NOT_ON_TIMER, TIMER0A, TIMER0B, TIMER1A, TIMER1B, TIMER1C, TIMER2, TIMER2A, TIMER2B,
+  TIMER3A, TIMER3B, TIMER3C, TIMER4A, TIMER4B, TIMER4C, TIMER4D, TIMER5A, TIMER5B, TIMER5C
+};
+
+// The simulator has no hardware PWM
+#define digitalPinToTimer(p) NOT_ON_TIMER
+
+#endif // _HAL_LINUX_PINS_ARDUINO_H_
@@ -0,0 +1,95 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * Host simulator entry point
+ *
+ *   marlin_sim [options] file.gcode
+ *
+ *   -w <lines>   Lines sent ahead of their "ok" (default 1), if the RX buffer has room
+ *   -l <ticks>   Stepper timer ticks each clock read costs the main loop (default 20)
+ *   -s <scale>   Also charge host time to the main loop, multiplied by <scale>
+ *                (the MCU to host speed ratio, ~50 for an AVR)
+ *   -a <raw>     Value of every ADC conversion (default 977, about 25°C)
+ *   -T <file>    Write every step to <file> as CSV: tick,axis,dir
+ *   -t <secs>    Stop after this much simulated time
+ *   -e <file>    Keep the EEPROM in <file>. It is saved at exit, even at the time limit.
+ *   -q           Don't print the firmware's output
+ *   -b           Send G0-G3 lines as binary frames (BINARY_GCODE_PROTOCOL).
+ *                Binary frames are numbered from 1, so the file must not number its lines.
+ *
+ * Heaters are not modelled. Begin the file with M302 P1 to allow extrusion.
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../MarlinConfig.h"
+#include "sim.h"
+
+#include <unistd.h>
+
+void setup();
+void loop();
+
+static void usage(const char * const name) {
+  fprintf(stderr, "Usage: %s [-w lines] [-l ticks] [-s scale] [-a raw] [-T trace.csv] [-t secs] [-e eeprom.bin] [-q] [-b] file.gcode\n", name);
+  exit(1);
+}
+
+int main(int argc, char *argv[]) {
+  int opt;
+  while ((opt = getopt(argc, argv, "w:l:s:a:T:t:e:qb")) != -1) {
+    switch (opt) {
+      case 'w': sim.window = constrain(atoi(optarg), 1, 255); break;
+      case 'l': sim.main_loop_ticks = atoi(optarg); break;
+      case 's': sim.cpu_scale = atof(optarg); break;
+      case 'a': sim.adc_value = atoi(optarg); break;
+      case 'T':
+        if (!(sim.step_trace = fopen(optarg, "w"))) { perror(optarg); return 1; }
+        break;
+      case 't': sim.time_limit = uint64_t(atof(optarg) * (STEPPER_TIMER_RATE)); break;
+      case 'e': sim.eeprom_file = optarg; break;
+      case 'q': sim.echo_output = false; break;
+      #if ENABLED(BINARY_GCODE_PROTOCOL)
+        case 'b': sim.binary_moves = true; break;
+      #endif
+      default: usage(argv[0]);
+    }
+  }
+  if (optind != argc - 1) usage(argv[0]);
+  if (!(sim.gcode_file = strcmp(argv[optind], "-") ? fopen(argv[optind], "r") : stdin)) {
+    perror(argv[optind]);
+    return 1;
+  }
+
+  setvbuf(stdout, NULL, _IOLBF, 0);
+  sim.init();
+  setup();
+  while (!sim.finished()) loop();
+  sim.report();
+
+  if (sim.step_trace) fclose(sim.step_trace);
+  return 0;
+}
+
+#endif // __PLAT_LINUX__
@@ -0,0 +1,635 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * Host simulator: clock, interrupt scheduler, serial host and step timing report
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../MarlinConfig.h"
+#include "../Marlin.h"
+#include "../planner.h"
+#include "../parser.h"
+#include "sim.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include <util/twi.h>
+#if defined(__x86_64__) || defined(__i386__)
+  #include <x86intrin.h>
+#endif
+
+Simulator sim;
+
+extern uint8_t commands_in_queue;
+void process_next_command();
+
+// Interrupt vectors defined by the firmware
+extern "C" void TIMER1_COMPA_vect(void);
+extern "C" void TIMER0_COMPB_vect(void);
+extern "C" void M_USARTx_RX_vect(void);
+extern "C" void TWI_vect(void) __attribute__((weak));  // Only with TWIBUS_ASYNC
+
+#define SIM_NEVER               UINT64_MAX
+#define SIM_TEMP_ISR_TICKS      uint32_t((STEPPER_TIMER_RATE) / (TEMP_TIMER_FREQUENCY))   // Timer 0 overflow period
+#define SIM_UART_BYTE_TICKS     uint32_t((STEPPER_TIMER_RATE) * 10UL / (BAUDRATE))        // 8N1 frame
+
+uint64_t sim_host_cycles() {
+  #if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+  #else
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return uint64_t(ts.tv_sec) * 1000000000ULL + ts.tv_nsec;
+  #endif
+}
+
+void sim_stat_add(sim_stat_t &stat, const uint64_t value) {
+  if (!stat.count++ || value < stat.min) stat.min = value;
+  if (value > stat.max) stat.max = value;
+  stat.total += value;
+}
+
+uint64_t Simulator::ticks, // = 0
+         Simulator::time_limit,
+         Simulator::excluded_cycles,
+         Simulator::steps,
+         Simulator::step_isrs,
+         Simulator::motor_port_writes,
+         Simulator::twi_bytes,
+         Simulator::twi_busy_ticks,
+         Simulator::eeprom_writes,
+         Simulator::starved_ticks;
+uint32_t Simulator::main_loop_ticks = 20, // 10µs
+         Simulator::starvations;
+float Simulator::cpu_scale; // = 0
+uint16_t Simulator::adc_value = 977; // About 25°C for the common 100k thermistors
+
+const char *Simulator::eeprom_file; // = NULL
+FILE *Simulator::gcode_file,
+     *Simulator::step_trace;
+uint8_t Simulator::window = 1;
+bool Simulator::echo_output = true,
+     Simulator::killed;
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  bool Simulator::binary_moves; // = false
+#endif
+
+sim_stat_t Simulator::step_isr_cycles,
+           Simulator::temp_isr_cycles,
+           Simulator::buffer_segment_cycles,
+           Simulator::prepare_move_cycles,
+           Simulator::process_command_cycles;
+
+// Scheduler state
+static bool in_isr;
+static uint64_t step_fire = SIM_NEVER, step_last_match, temp_fire = SIM_NEVER, rx_fire = SIM_NEVER, rx_last, twi_fire = SIM_NEVER;
+static hal_timer_t step_compare;
+static double host_cycles_per_tick;
+static uint64_t last_tick_cycles, last_tick_excluded;
+
+uint32_t HAL_profile_us() {
+  return host_cycles_per_tick ? uint32_t(sim_host_cycles() / (host_cycles_per_tick * (STEPPER_TIMER_TICKS_PER_US))) : 0;
+}
+
+// Host state
+static char host_line[MAX_CMD_SIZE + 2], out_line[256];
+static uint8_t host_len, host_pos, out_pos, unacked, rx_data;
+static bool gcode_eof, host_sending;
+static uint64_t host_bytes;
+
+// Lengths of the lines awaiting "ok", to keep the firmware's RX buffer from overflowing
+static uint8_t unacked_len[256], unacked_tail;
+static uint16_t unacked_bytes;
+
+// Starvation state
+static bool was_queued, starving;
+static uint64_t starve_start;
+
+// --------------------------------------------------------------------------
+// Step tracing
+// --------------------------------------------------------------------------
+
+typedef struct {
+  const char *name;
+  SimPortRegister *step_port;
+  uint8_t step_bit;
+  bool step_invert;
+  SimPortRegister *dir_port;
+  uint8_t dir_bit;
+  bool dir_invert;
+} sim_axis_t;
+
+#define _SIM_WPORT(IO) DIO ## IO ## _WPORT
+#define _SIM_BIT(IO) DIO ## IO ## _PIN
+#define SIM_WPORT(IO) _SIM_WPORT(IO)
+#define SIM_BIT(IO) _SIM_BIT(IO)
+#define SIM_AXIS(N,A,INV) { N, &SIM_WPORT(A##_STEP_PIN), SIM_BIT(A##_STEP_PIN), INV, &SIM_WPORT(A##_DIR_PIN), SIM_BIT(A##_DIR_PIN), INVERT_##A##_DIR }
+
+static const sim_axis_t sim_axes[] = {
+  #if ENABLED(HANGPRINTER)
+    SIM_AXIS("A", A, INVERT_A_STEP_PIN),
+    SIM_AXIS("B", B, INVERT_B_STEP_PIN),
+    SIM_AXIS("C", C, INVERT_C_STEP_PIN),
+    SIM_AXIS("D", D, INVERT_D_STEP_PIN),
+  #else
+    #if HAS_X_STEP
+      SIM_AXIS("X", X, INVERT_X_STEP_PIN),
+    #endif
+    #if HAS_Y_STEP
+      SIM_AXIS("Y", Y, INVERT_Y_STEP_PIN),
+    #endif
+    #if HAS_Z_STEP
+      SIM_AXIS("Z", Z, INVERT_Z_STEP_PIN),
+    #endif
+  #endif
+  #if E_STEPPERS > 0 && HAS_E0_STEP
+    SIM_AXIS("E0", E0, INVERT_E_STEP_PIN),
+  #endif
+  #if E_STEPPERS > 1 && HAS_E1_STEP
+    SIM_AXIS("E1", E1, INVERT_E_STEP_PIN),
+  #endif
+  #if E_STEPPERS > 2 && HAS_E2_STEP
+    SIM_AXIS("E2", E2, INVERT_E_STEP_PIN),
+  #endif
+  #if E_STEPPERS > 3 && HAS_E3_STEP
+    SIM_AXIS("E3", E3, INVERT_E_STEP_PIN),
+  #endif
+  #if E_STEPPERS > 4 && HAS_E4_STEP
+    SIM_AXIS("E4", E4, INVERT_E_STEP_PIN),
+  #endif
+};
+
+static uint64_t axis_steps[COUNT(sim_axes)];
+
+void Simulator::port_changed(const uint8_t port, const uint8_t old_value, const uint8_t new_value) {
+  bool motor_pins = false;
+  for (uint8_t i = 0; i < COUNT(sim_axes); i++) {
+    const sim_axis_t &a = sim_axes[i];
+    if (a.dir_port->port == port && TEST(old_value ^ new_value, a.dir_bit)) motor_pins = true;
+    if (a.step_port->port != port) continue;
+    const uint8_t mask = _BV(a.step_bit);
+    if ((old_value ^ new_value) & mask) motor_pins = true;
+    if (!((old_value ^ new_value) & mask) || !(new_value & mask) == !a.step_invert) continue;
+    axis_steps[i]++;
+    steps++;
+    if (step_trace)
+      fprintf(step_trace, "%llu,%s,%c\n", (unsigned long long)ticks, a.name, TEST(*a.dir_port, a.dir_bit) != a.dir_invert ? '+' : '-');
+  }
+  if (motor_pins) motor_port_writes++;
+}
+
+// --------------------------------------------------------------------------
+// Timers and ADC
+// --------------------------------------------------------------------------
+
+void HAL_timer_start(const uint8_t timer_num, const uint32_t frequency) {
+  UNUSED(frequency);
+  switch (timer_num) {
+    case STEP_TIMER_NUM:
+      // Like the AVR HAL: CTC mode, OCR1A = 0x4000, counting from 0
+      step_compare = 0x4000;
+      step_last_match = Simulator::ticks;
+      step_fire = step_last_match + step_compare;
+      break;
+    case TEMP_TIMER_NUM:
+      temp_fire = Simulator::ticks + SIM_TEMP_ISR_TICKS;
+      break;
+  }
+}
+
+/**
+ * The step timer runs in CTC mode: it counts up from the last match. A compare
+ * value already passed by the count only matches after the 16-bit wrap.
+ */
+void HAL_timer_set_compare(const uint8_t timer_num, const hal_timer_t compare) {
+  if (timer_num != STEP_TIMER_NUM) return;
+  step_compare = compare;
+  step_fire = step_last_match + compare;
+  if (step_fire < Simulator::ticks) step_fire += 0x10000;
+}
+
+hal_timer_t HAL_timer_get_compare(const uint8_t timer_num) {
+  return timer_num == STEP_TIMER_NUM ? step_compare : 0;
+}
+
+// Every read costs one tick, so busy-waits on the counter terminate
+hal_timer_t HAL_timer_get_count(const uint8_t timer_num) {
+  const uint64_t now = Simulator::ticks++;
+  return timer_num == STEP_TIMER_NUM ? hal_timer_t(now - step_last_match) : hal_timer_t(now / 8);
+}
+
+void HAL_start_adc(const uint8_t pin) { UNUSED(pin); }
+
+uint16_t HAL_read_adc(void) { return Simulator::adc_value; }
+
+// --------------------------------------------------------------------------
+// I2C bus. Every slave acknowledges and reads return zeros, like the Wire stub.
+// --------------------------------------------------------------------------
+
+static uint8_t twi_status;              // TWSR when the bus event is done
+static bool twi_owned,                  // Between START and STOP
+            twi_addressing,             // The next byte is an address
+            twi_reading;
+
+void Simulator::twi_control(const uint8_t v) {
+  // Writing TWINT clears the flag and starts the next bus event
+  if (!TEST(v, TWEN) || !TEST(v, TWINT)) return;
+  CBI(TWCR.value, TWINT);
+
+  if (TEST(v, TWSTO)) {
+    CBI(TWCR.value, TWSTO);
+    twi_owned = false;
+    if (!TEST(v, TWSTA)) return;
+  }
+
+  uint8_t bits = 9; // A byte and its acknowledge
+  if (TEST(v, TWSTA)) {
+    twi_status = twi_owned ? TW_REP_START : TW_START;
+    twi_owned = twi_addressing = true;
+    bits = 1;
+  }
+  else if (twi_addressing) {
+    twi_reading = TEST(TWDR, 0);
+    twi_status = twi_reading ? TW_MR_SLA_ACK : TW_MT_SLA_ACK;
+    twi_addressing = false;
+  }
+  else {
+    twi_status = !twi_reading ? TW_MT_DATA_ACK : TEST(v, TWEA) ? TW_MR_DATA_ACK : TW_MR_DATA_NACK;
+    twi_bytes++;
+  }
+
+  // SCL runs at F_CPU / (16 + 2 * TWBR * prescaler)
+  const uint32_t scl_ticks = uint64_t(STEPPER_TIMER_RATE) * (16 + 2UL * TWBR * _BV(2 * (TWSR & 0x03))) / (F_CPU);
+  twi_busy_ticks += bits * scl_ticks;
+  twi_fire = ticks + bits * scl_ticks;
+}
+
+// --------------------------------------------------------------------------
+// Planner profiling (needs -finstrument-functions)
+// --------------------------------------------------------------------------
+
+enum SimProbe : uint8_t { PROBE_IDLE, PROBE_PROCESS, PROBE_PREPARE, PROBE_SEGMENT, PROBE_COUNT };
+
+static void *probe_fn[PROBE_COUNT];
+static sim_stat_t * const probe_stat[PROBE_COUNT] = {
+  NULL, &Simulator::process_command_cycles, &Simulator::prepare_move_cycles, &Simulator::buffer_segment_cycles
+};
+static struct { uint64_t start, excluded; uint8_t depth; } probe_state[PROBE_COUNT];
+
+// Busy-wait loops around idle() (e.g., for a free planner block) don't count either
+static uint32_t hook_entries, idle_exit_entries;
+static uint64_t idle_exit_cycles;
+
+extern "C" {
+
+  void __cyg_profile_func_enter(void *fn, void *caller) __attribute__((no_instrument_function));
+  void __cyg_profile_func_exit(void *fn, void *caller) __attribute__((no_instrument_function));
+
+  void __cyg_profile_func_enter(void *fn, void *caller) {
+    UNUSED(caller);
+    const uint64_t now = sim_host_cycles();
+    hook_entries++;
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) if (fn == probe_fn[i]) {
+      if (i == PROBE_IDLE && hook_entries == idle_exit_entries + 1)
+        Simulator::excluded_cycles += now - idle_exit_cycles;
+      if (!probe_state[i].depth++) {
+        probe_state[i].excluded = Simulator::excluded_cycles;
+        probe_state[i].start = now;
+      }
+      return;
+    }
+  }
+
+  void __cyg_profile_func_exit(void *fn, void *caller) {
+    UNUSED(caller);
+    const uint64_t now = sim_host_cycles();
+    for (uint8_t i = 0; i < PROBE_COUNT; i++) if (fn == probe_fn[i]) {
+      if (probe_state[i].depth && !--probe_state[i].depth) {
+        const uint64_t elapsed = now - probe_state[i].start - (Simulator::excluded_cycles - probe_state[i].excluded);
+        if (probe_stat[i])
+          sim_stat_add(*probe_stat[i], elapsed);
+        else {
+          // Time in idle() doesn't count against the caller
+          Simulator::excluded_cycles += elapsed;
+          idle_exit_entries = hook_entries;
+          idle_exit_cycles = now;
+        }
+      }
+      return;
+    }
+  }
+
+}
+
+// --------------------------------------------------------------------------
+// Serial host
+// --------------------------------------------------------------------------
+
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+
+  // Encode a G0-G3 line as a binary frame (see BINARY_GCODE_PROTOCOL), if it has only frame words
+  static bool host_encode_binary(const char *p, const char * const end) {
+    static uint16_t line_number;
+    if (p[0] != 'G' || !WITHIN(p[1], '0', '3') || (p + 2 < end && p[2] != ' ')) return false;
+    const uint8_t code = p[1] - '0';
+    int32_t value[8];
+    uint8_t words = 0;
+    for (p += 2; p < end;) {
+      if (*p == ' ') { p++; continue; }
+      const char * const w = strchr(BINARY_WORDS, *p);
+      if (!w) return false;
+      const uint8_t i = w - BINARY_WORDS;
+      char *e;
+      const double v = strtod(p + 1, &e);
+      if (e == p + 1 || TEST(words, i)) return false;
+      SBI(words, i);
+      value[i] = int32_t(lround(v * 1000));
+      p = e;
+    }
+    line_number++;
+    uint8_t *f = (uint8_t*)host_line, len = 0;
+    f[len++] = BINARY_FRAME_SYNC;
+    f[len++] = code;
+    f[len++] = words;
+    f[len++] = line_number & 0xFF;
+    f[len++] = line_number >> 8;
+    for (uint8_t i = 0; i < 8; i++) if (TEST(words, i))
+      for (uint8_t b = 0; b < 32; b += 8) f[len++] = uint32_t(value[i]) >> b;
+    uint16_t crc = 0;
+    crc16(&crc, f + 1, len - 1);
+    f[len++] = crc & 0xFF;
+    f[len++] = crc >> 8;
+    host_len = len;
+    return true;
+  }
+
+#endif
+
+// Read the next line to send, without comments and blank lines, like a host program
+static bool host_read_line() {
+  char buf[256];
+  while (fgets(buf, sizeof(buf), Simulator::gcode_file)) {
+    char *end = strchr(buf, ';');
+    if (!end) end = buf + strlen(buf);
+    while (end > buf && (end[-1] == '\n' || end[-1] == '\r' || end[-1] == ' ' || end[-1] == '\t')) end--;
+    char *start = buf;
+    while (start < end && (*start == ' ' || *start == '\t')) start++;
+    if (start == end) continue;
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      if (Simulator::binary_moves && host_encode_binary(start, end)) return true;
+    #endif
+    const size_t len = MIN(size_t(end - start), sizeof(host_line) - 2);
+    memcpy(host_line, start, len);
+    host_line[len] = '\n';
+    host_len = len + 1;
+    return true;
+  }
+  gcode_eof = true;
+  return false;
+}
+
+// Schedule the next byte to the firmware, if there is one
+void Simulator::host_step() {
+  if (!TEST(M_UCSRxB, M_RXCIEx)) return;
+  if (!host_sending) {
+    if (!host_len && (gcode_eof || !gcode_file || !host_read_line())) return;
+    // Like a host counting characters, never send more than the RX buffer holds
+    if (unacked >= window || unacked_bytes + host_len > RX_BUFFER_SIZE - 1) return;
+    unacked_len[uint8_t(unacked_tail + unacked++)] = host_len;
+    unacked_bytes += host_len;
+    host_sending = true;
+    host_pos = 0;
+  }
+  rx_fire = MAX(ticks, rx_last) + SIM_UART_BYTE_TICKS;
+}
+
+uint8_t Simulator::uart_rx() {
+  CBI(M_UCSRxA, M_RXCx);
+  return rx_data;
+}
+
+void Simulator::uart_tx(const uint8_t c) {
+  if (c == '\r') return;
+  if (c != '\n' && out_pos < sizeof(out_line) - 1) {
+    out_line[out_pos++] = c;
+    return;
+  }
+  out_line[out_pos] = '\0';
+  out_pos = 0;
+  if (echo_output) puts(out_line);
+  if (!strncmp(out_line, "ok", 2) && unacked) {
+    unacked--;
+    unacked_bytes -= unacked_len[unacked_tail++];
+  }
+  if (strstr(out_line, MSG_ERR_KILLED)) killed = true;
+}
+
+static bool input_pending() {
+  return !gcode_eof || unacked || host_len || commands_in_queue;
+}
+
+bool Simulator::finished() {
+  return !input_pending() && !planner.has_blocks_queued();
+}
+
+// --------------------------------------------------------------------------
+// Clock
+// --------------------------------------------------------------------------
+
+void Simulator::watch_planner() {
+  const bool queued = planner.has_blocks_queued();
+  if (queued == was_queued) return;
+  was_queued = queued;
+  if (!queued) {
+    if (input_pending()) { starvations++; starving = true; starve_start = ticks; }
+  }
+  else if (starving) {
+    starved_ticks += ticks - starve_start;
+    starving = false;
+  }
+}
+
+void Simulator::dispatch(const uint64_t until) {
+  for (;;) {
+    if (rx_fire == SIM_NEVER) host_step();
+
+    // Earliest enabled interrupt due by 'until'
+    enum : uint8_t { EV_NONE, EV_STEP, EV_TEMP, EV_RX, EV_TWI } ev = EV_NONE;
+    uint64_t next = until;
+    if (TEST(SREG, SREG_I)) {
+      if (TEST(TIMSK1, OCIE1A) && step_fire <= next) { ev = EV_STEP; next = step_fire; }
+      if (TEST(TIMSK0, OCIE0B) && temp_fire < next) { ev = EV_TEMP; next = temp_fire; }
+      if (rx_fire < next) { ev = EV_RX; next = rx_fire; }
+      if (TEST(TWCR.value, TWIE) && twi_fire < next) { ev = EV_TWI; next = twi_fire; }
+    }
+    if (ev == EV_NONE) break;
+    NOLESS(ticks, next);
+
+    // The hardware clears the I flag on entry and RETI sets it again
+    in_isr = true;
+    CBI(SREG, SREG_I);
+    const uint64_t start = sim_host_cycles();
+    switch (ev) {
+      case EV_STEP: {
+        step_last_match = step_fire;
+        step_fire += 0x10000;
+        const uint64_t steps_before = steps;
+        TIMER1_COMPA_vect();
+        sim_stat_add(step_isr_cycles, sim_host_cycles() - start);
+        if (steps != steps_before) step_isrs++;
+        watch_planner();
+      } break;
+      case EV_TEMP:
+        temp_fire += SIM_TEMP_ISR_TICKS;
+        NOLESS(temp_fire, ticks + 1);
+        TIMER0_COMPB_vect();
+        sim_stat_add(temp_isr_cycles, sim_host_cycles() - start);
+        break;
+      case EV_RX:
+        rx_last = rx_fire;
+        rx_fire = SIM_NEVER;
+        rx_data = host_line[host_pos++];
+        host_bytes++;
+        if (host_pos == host_len) {
+          host_sending = false;
+          host_len = 0;
+        }
+        SBI(M_UCSRxA, M_RXCx);
+        M_USARTx_RX_vect();
+        break;
+      case EV_TWI:
+        twi_fire = SIM_NEVER;
+        TWSR = (TWSR & ~TW_STATUS_MASK) | twi_status;
+        if (twi_status == TW_MR_DATA_ACK || twi_status == TW_MR_DATA_NACK) TWDR = 0;
+        SBI(TWCR.value, TWINT);
+        if (TWI_vect) TWI_vect();
+        break;
+      default: break;
+    }
+    SBI(SREG, SREG_I);
+    in_isr = false;
+  }
+  NOLESS(ticks, until);
+}
+
+void Simulator::advance(const uint32_t t) {
+  if (killed) {
+    // kill() waits here after reporting the halt
+    report();
+    exit(1);
+  }
+  if (in_isr) { ticks += t; return; }
+  const uint64_t start = sim_host_cycles();
+  dispatch(ticks + t);
+  watch_planner();
+  excluded_cycles += sim_host_cycles() - start;
+  if (time_limit && ticks > time_limit) {
+    SERIAL_ECHOLNPGM("Simulation time limit reached");
+    report();
+    exit(2);
+  }
+}
+
+void Simulator::main_loop_tick() {
+  if (in_isr) return;
+  uint32_t t = main_loop_ticks;
+  const uint64_t now = sim_host_cycles();
+  if (cpu_scale > 0) {
+    const uint64_t busy = (now - last_tick_cycles) - (excluded_cycles - last_tick_excluded);
+    t += uint32_t(busy * cpu_scale / host_cycles_per_tick);
+  }
+  advance(t);
+  last_tick_cycles = sim_host_cycles();
+  last_tick_excluded = excluded_cycles;
+}
+
+// --------------------------------------------------------------------------
+// Setup and report
+// --------------------------------------------------------------------------
+
+void Simulator::init() {
+  sim_eeprom_init();
+
+  // Calibrate the host cycle counter against the wall clock
+  timespec t0, t1;
+  clock_gettime(CLOCK_MONOTONIC, &t0);
+  const uint64_t c0 = sim_host_cycles();
+  do clock_gettime(CLOCK_MONOTONIC, &t1); while ((t1.tv_sec - t0.tv_sec) * 1000000000L + (t1.tv_nsec - t0.tv_nsec) < 20000000L);
+  const double ns = (t1.tv_sec - t0.tv_sec) * 1e9 + (t1.tv_nsec - t0.tv_nsec);
+  host_cycles_per_tick = (sim_host_cycles() - c0) / ns * (1e9 / (STEPPER_TIMER_RATE));
+
+  probe_fn[PROBE_IDLE]    = reinterpret_cast<void*>(&idle);
+  probe_fn[PROBE_PROCESS] = reinterpret_cast<void*>(&process_next_command);
+  probe_fn[PROBE_PREPARE] = reinterpret_cast<void*>(&prepare_move_to_destination);
+  probe_fn[PROBE_SEGMENT] = reinterpret_cast<void*>(&Planner::buffer_segment);
+
+  if (step_trace) fputs("tick,axis,dir\n", step_trace);
+  last_tick_cycles = sim_host_cycles();
+}
+
+static void report_stat(const char * const name, const sim_stat_t &stat, const uint64_t per = 0) {
+  if (!stat.count) {
+    fprintf(stderr, "  %-28s -\n", name);
+    return;
+  }
+  fprintf(stderr, "  %-28s %10lu calls, cycles avg %8.0f min %8llu max %8llu", name,
+    (unsigned long)stat.count, double(stat.total) / stat.count, (unsigned long long)stat.min, (unsigned long long)stat.max);
+  if (per) fprintf(stderr, ", %.0f per step", double(stat.total) / per);
+  fputc('\n', stderr);
+}
+
+void Simulator::report() {
+  if (step_trace) fflush(step_trace);
+  fflush(stdout);
+  sim_eeprom_save();  // As it is now, like after a power cut at the time limit
+
+  fprintf(stderr, "\nSimulated time %.3fs, host cycle counter %.0fMHz\n",
+    double(ticks) / (STEPPER_TIMER_RATE), host_cycles_per_tick * (STEPPER_TIMER_RATE) / 1e6);
+
+  fprintf(stderr, "  Steps %llu in %llu ISRs:", (unsigned long long)steps, (unsigned long long)step_isrs);
+  for (uint8_t i = 0; i < COUNT(sim_axes); i++)
+    fprintf(stderr, " %s %llu", sim_axes[i].name, (unsigned long long)axis_steps[i]);
+  fputc('\n', stderr);
+  fprintf(stderr, "  Step and direction pins changed by %llu port writes\n", (unsigned long long)motor_port_writes);
+
+  fprintf(stderr, "  Host sent %llu bytes\n", (unsigned long long)host_bytes);
+  if (twi_bytes)
+    fprintf(stderr, "  I2C bus moved %llu bytes, busy %.3fs\n", (unsigned long long)twi_bytes, double(twi_busy_ticks) / (STEPPER_TIMER_RATE));
+  if (eeprom_writes)
+    fprintf(stderr, "  EEPROM written %llu times, %.3fs, the most worn byte %lu times\n", (unsigned long long)eeprom_writes,
+      double(eeprom_writes * (SIM_EEPROM_WRITE_TICKS)) / (STEPPER_TIMER_RATE), (unsigned long)sim_eeprom_max_wear());
+
+  report_stat("Stepper ISR", step_isr_cycles, steps);
+  report_stat("Temperature ISR", temp_isr_cycles);
+  report_stat("process_next_command", process_command_cycles);
+  report_stat("prepare_move_to_destination", prepare_move_cycles);
+  report_stat("Planner::buffer_segment", buffer_segment_cycles);
+  if (!buffer_segment_cycles.count) fputs("  (Build with -finstrument-functions to profile the planner)\n", stderr);
+
+  fprintf(stderr, "  Planner starved %lu times, %.3fs in total\n",
+    (unsigned long)starvations, double(starved_ticks + (starving ? ticks - starve_start : 0)) / (STEPPER_TIMER_RATE));
+}
+
+#endif // __PLAT_LINUX__
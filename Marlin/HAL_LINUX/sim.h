@@ -0,0 +1,126 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * Host simulator for the planner and stepper pipeline
+ *
+ * The whole firmware runs single-threaded on the host. Simulated time is
+ * counted in stepper timer ticks (STEPPER_TIMER_RATE) and only advances when
+ * the firmware asks for it (millis(), micros(), delay()). Each such call
+ * costs the main loop at least `main_loop_ticks`, and optionally the host
+ * time spent since the previous call scaled by `cpu_scale`. Due interrupts
+ * (stepper, temperature, UART) are then dispatched in time order.
+ *
+ * A G-code file is streamed into the UART the way a host program would,
+ * waiting for "ok" before sending more lines. Every step pulse is counted
+ * and, optionally, written to a trace with its tick. At exit a report of
+ * ISR and planner cost on the host and of buffer starvation is printed.
+ */
+
+#ifndef _HAL_LINUX_SIM_H_
+#define _HAL_LINUX_SIM_H_
+
+#include <stdint.h>
+#include <stdio.h>
+
+// Cost counter of the host, used for the ISR and planner figures
+uint64_t sim_host_cycles();
+
+typedef struct {
+  uint32_t count;
+  uint64_t total, min, max;
+} sim_stat_t;
+
+void sim_stat_add(sim_stat_t &stat, const uint64_t value);
+
+class Simulator {
+  public:
+    // Clock
+    static uint64_t ticks;                  // Simulated time, in stepper timer ticks
+    static uint32_t main_loop_ticks;        // Minimum cost of the main loop between two clock reads
+    static float cpu_scale;                 // Host time to simulated time ratio. 0 to disable.
+    static uint64_t excluded_cycles;        // Host cycles spent in ISRs and in the simulator itself
+    static uint64_t time_limit;             // Give up after this many ticks. 0 for no limit.
+
+    // Every analog input reads this
+    static uint16_t adc_value;
+
+    // Host side of the serial line
+    static FILE *gcode_file;
+    static uint8_t window;                  // Lines sent ahead of their "ok"
+    static bool echo_output;                // Print firmware output on stdout
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      static bool binary_moves;             // Send G0-G3 as binary frames
+    #endif
+
+    // Stepper
+    static FILE *step_trace;
+    static uint64_t steps, step_isrs;
+    static uint64_t motor_port_writes;      // Port writes changing step or direction pins
+    static sim_stat_t step_isr_cycles;
+    static sim_stat_t temp_isr_cycles;
+
+    // I2C bus
+    static uint64_t twi_bytes, twi_busy_ticks;
+
+    // EEPROM
+    static const char *eeprom_file;         // Loaded at start and saved at exit, also at the time limit
+    static uint64_t eeprom_writes;
+
+    // Planner feeding
+    static uint32_t starvations;
+    static uint64_t starved_ticks;
+
+    // Profiled main loop functions, exclusive of ISRs and idle()
+    static sim_stat_t buffer_segment_cycles,
+                      prepare_move_cycles,
+                      process_command_cycles;
+
+    static bool killed;
+
+    static void init();
+    static void advance(const uint32_t t);  // Run the clock ahead, dispatching interrupts
+    static void main_loop_tick();           // A clock read from the main loop
+    static bool finished();                 // All G-code sent, acknowledged and executed
+    static void report();
+
+    // Hooks for sim_hardware.cpp
+    static void uart_tx(const uint8_t c);
+    static uint8_t uart_rx();
+    static void port_changed(const uint8_t port, const uint8_t old_value, const uint8_t new_value);
+    static void twi_control(const uint8_t v);
+
+  private:
+    static void dispatch(const uint64_t until);
+    static void host_step();
+    static void watch_planner();
+};
+
+extern Simulator sim;
+
+#define SIM_EEPROM_WRITE_TICKS ((STEPPER_TIMER_RATE) / 10000 * 34) // 3.4ms
+
+void sim_eeprom_init();
+void sim_eeprom_save();
+uint32_t sim_eeprom_max_wear();
+
+#endif // _HAL_LINUX_SIM_H_
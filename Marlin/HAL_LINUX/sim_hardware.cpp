@@ -0,0 +1,266 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+/**
+ * Simulated ATmega2560 peripherals and Arduino core functions
+ */
+
+#ifdef __PLAT_LINUX__
+
+#include "../MarlinConfig.h"
+#include "sim.h"
+
+#include <Wire.h>
+
+// --------------------------------------------------------------------------
+// Registers
+// --------------------------------------------------------------------------
+
+#define _SIM_PORT(P,N) SimPortRegister PORT##P(N); SimPinRegister PIN##P(PORT##P); volatile uint8_t DDR##P
+_SIM_PORT(A,0); _SIM_PORT(B,1); _SIM_PORT(C,2); _SIM_PORT(D,3); _SIM_PORT(E,4); _SIM_PORT(F,5);
+_SIM_PORT(G,6); _SIM_PORT(H,7); _SIM_PORT(J,8); _SIM_PORT(K,9); _SIM_PORT(L,10);
+#undef _SIM_PORT
+
+volatile uint8_t SREG = _BV(SREG_I), MCUSR = _BV(PORF);
+
+#define _SIM_TIMER8(T)  volatile uint8_t TCCR##T##A, TCCR##T##B, TIMSK##T, TIFR##T, TCNT##T, OCR##T##A, OCR##T##B
+#define _SIM_TIMER16(T) volatile uint8_t TCCR##T##A, TCCR##T##B, TCCR##T##C, TIMSK##T, TIFR##T; \
+                        volatile uint16_t TCNT##T, OCR##T##A, OCR##T##B, OCR##T##C, ICR##T
+_SIM_TIMER8(0); _SIM_TIMER8(2);
+_SIM_TIMER16(1); _SIM_TIMER16(3); _SIM_TIMER16(4); _SIM_TIMER16(5);
+#undef _SIM_TIMER8
+#undef _SIM_TIMER16
+
+volatile uint8_t PCICR, PCIFR, PCMSK0, PCMSK1, PCMSK2, EICRA, EICRB, EIMSK, EIFR;
+volatile uint8_t ADCSRA, ADCSRB, ADMUX, DIDR0, DIDR2;
+volatile uint8_t PRR0, PRR1;
+volatile uint8_t SPCR, SPSR = _BV(SPIF), SPDR;
+volatile uint8_t TWBR, TWSR, TWDR, TWAR;
+SimTwiControl TWCR;
+
+#define _SIM_UART(N) SimUartData UDR##N(N); SimUartStatus UCSR##N##A(_BV(UDRE##N) | _BV(TXC##N)); \
+  volatile uint8_t UCSR##N##B, UCSR##N##C, UBRR##N##H, UBRR##N##L
+_SIM_UART(0); _SIM_UART(1); _SIM_UART(2); _SIM_UART(3);
+#undef _SIM_UART
+
+void sim_port_changed(const uint8_t port, const uint8_t old_value, const uint8_t new_value) {
+  Simulator::port_changed(port, old_value, new_value);
+}
+
+// Only the host port is connected
+void sim_uart_tx(const uint8_t port, const uint8_t c) {
+  if (port == SERIAL_PORT) Simulator::uart_tx(c);
+}
+
+uint8_t sim_uart_rx(const uint8_t port) {
+  return port == SERIAL_PORT ? Simulator::uart_rx() : 0;
+}
+
+void sim_twi_control(const uint8_t v) { Simulator::twi_control(v); }
+
+// --------------------------------------------------------------------------
+// Arduino pins
+// --------------------------------------------------------------------------
+
+typedef struct {
+  SimPortRegister *port;
+  SimPinRegister *pin;
+  volatile uint8_t *ddr;
+  uint8_t bit;
+} sim_pin_t;
+
+#define _SIM_PIN(IO) { &DIO ## IO ## _WPORT, &DIO ## IO ## _RPORT, &DIO ## IO ## _DDR, DIO ## IO ## _PIN }
+
+static const sim_pin_t sim_pins[] = {
+  _SIM_PIN(0), _SIM_PIN(1), _SIM_PIN(2), _SIM_PIN(3), _SIM_PIN(4), _SIM_PIN(5), _SIM_PIN(6),
+  _SIM_PIN(7), _SIM_PIN(8), _SIM_PIN(9), _SIM_PIN(10), _SIM_PIN(11), _SIM_PIN(12), _SIM_PIN(13),
+  _SIM_PIN(14), _SIM_PIN(15), _SIM_PIN(16), _SIM_PIN(17), _SIM_PIN(18), _SIM_PIN(19), _SIM_PIN(20),
+  _SIM_PIN(21), _SIM_PIN(22), _SIM_PIN(23), _SIM_PIN(24), _SIM_PIN(25), _SIM_PIN(26), _SIM_PIN(27),
+  _SIM_PIN(28), _SIM_PIN(29), _SIM_PIN(30), _SIM_PIN(31), _SIM_PIN(32), _SIM_PIN(33), _SIM_PIN(34),
+  _SIM_PIN(35), _SIM_PIN(36), _SIM_PIN(37), _SIM_PIN(38), _SIM_PIN(39), _SIM_PIN(40), _SIM_PIN(41),
+  _SIM_PIN(42), _SIM_PIN(43), _SIM_PIN(44), _SIM_PIN(45), _SIM_PIN(46), _SIM_PIN(47), _SIM_PIN(48),
+  _SIM_PIN(49), _SIM_PIN(50), _SIM_PIN(51), _SIM_PIN(52), _SIM_PIN(53), _SIM_PIN(54), _SIM_PIN(55),
+  _SIM_PIN(56), _SIM_PIN(57), _SIM_PIN(58), _SIM_PIN(59), _SIM_PIN(60), _SIM_PIN(61), _SIM_PIN(62),
+  _SIM_PIN(63), _SIM_PIN(64), _SIM_PIN(65), _SIM_PIN(66), _SIM_PIN(67), _SIM_PIN(68), _SIM_PIN(69),
+  _SIM_PIN(70), _SIM_PIN(71), _SIM_PIN(72), _SIM_PIN(73), _SIM_PIN(74), _SIM_PIN(75), _SIM_PIN(76),
+  _SIM_PIN(77), _SIM_PIN(78), _SIM_PIN(79), _SIM_PIN(80), _SIM_PIN(81), _SIM_PIN(82), _SIM_PIN(83),
+  _SIM_PIN(84), _SIM_PIN(85)
+};
+
+#define SIM_PIN_VALID(P) ((P) < COUNT(sim_pins))
+
+void pinMode(const uint8_t pin, const uint8_t mode) {
+  if (!SIM_PIN_VALID(pin)) return;
+  const sim_pin_t &p = sim_pins[pin];
+  if (mode == OUTPUT)
+    SBI(*p.ddr, p.bit);
+  else {
+    CBI(*p.ddr, p.bit);
+    if (mode == INPUT_PULLUP) *p.port |= _BV(p.bit); else *p.port &= ~_BV(p.bit);
+  }
+}
+
+void digitalWrite(const uint8_t pin, const uint8_t val) {
+  if (!SIM_PIN_VALID(pin)) return;
+  const sim_pin_t &p = sim_pins[pin];
+  if (val) *p.port |= _BV(p.bit); else *p.port &= ~_BV(p.bit);
+}
+
+int digitalRead(const uint8_t pin) {
+  if (!SIM_PIN_VALID(pin)) return LOW;
+  const sim_pin_t &p = sim_pins[pin];
+  return TEST(*p.pin, p.bit) ? HIGH : LOW;
+}
+
+void analogWrite(const uint8_t pin, const int val) { digitalWrite(pin, val >= 128); }
+
+int analogRead(const uint8_t pin) { HAL_start_adc(pin); return HAL_read_adc(); }
+
+void attachInterrupt(const uint8_t irq, void (*fn)(), const int mode) { UNUSED(irq); UNUSED(fn); UNUSED(mode); }
+void detachInterrupt(const uint8_t irq) { UNUSED(irq); }
+
+// --------------------------------------------------------------------------
+// Time
+// --------------------------------------------------------------------------
+
+uint32_t millis() {
+  Simulator::main_loop_tick();
+  return Simulator::ticks / ((STEPPER_TIMER_RATE) / 1000);
+}
+
+uint32_t micros() {
+  Simulator::main_loop_tick();
+  return Simulator::ticks / (STEPPER_TIMER_TICKS_PER_US);
+}
+
+void delay(const uint32_t ms) { Simulator::advance(ms * ((STEPPER_TIMER_RATE) / 1000)); }
+
+void delayMicroseconds(const uint32_t us) { Simulator::advance(us * (STEPPER_TIMER_TICKS_PER_US)); }
+
+// --------------------------------------------------------------------------
+// EEPROM, erased at every start unless kept in a file. A write takes 3.4ms,
+// during which the next read or write waits, as on the AVR.
+// --------------------------------------------------------------------------
+
+static uint8_t sim_eeprom[E2END + 1];
+static uint32_t sim_eeprom_wear[E2END + 1];   // Writes to each cell
+static uint64_t sim_eeprom_ready;             // Tick when the last write is done
+
+void sim_eeprom_init() {
+  memset(sim_eeprom, 0xFF, sizeof(sim_eeprom));
+  if (Simulator::eeprom_file) {
+    FILE * const f = fopen(Simulator::eeprom_file, "rb");
+    if (f) {
+      if (fread(sim_eeprom, 1, sizeof(sim_eeprom), f)) { /* A short file leaves the rest erased */ }
+      fclose(f);
+    }
+  }
+}
+
+void sim_eeprom_save() {
+  if (!Simulator::eeprom_file) return;
+  FILE * const f = fopen(Simulator::eeprom_file, "wb");
+  if (!f) { perror(Simulator::eeprom_file); return; }
+  fwrite(sim_eeprom, 1, sizeof(sim_eeprom), f);
+  fclose(f);
+}
+
+uint32_t sim_eeprom_max_wear() {
+  uint32_t m = 0;
+  for (uint16_t i = 0; i <= E2END; i++) NOLESS(m, sim_eeprom_wear[i]);
+  return m;
+}
+
+static void sim_eeprom_wait() {
+  if (Simulator::ticks < sim_eeprom_ready) Simulator::advance(sim_eeprom_ready - Simulator::ticks);
+}
+
+uint8_t eeprom_read_byte(const uint8_t *pos) {
+  const uintptr_t p = (uintptr_t)pos;
+  sim_eeprom_wait();
+  return p <= E2END ? sim_eeprom[p] : 0xFF;
+}
+
+void eeprom_write_byte(uint8_t *pos, const uint8_t value) {
+  const uintptr_t p = (uintptr_t)pos;
+  sim_eeprom_wait();
+  if (p > E2END) return;
+  sim_eeprom[p] = value;
+  sim_eeprom_wear[p]++;
+  Simulator::eeprom_writes++;
+  sim_eeprom_ready = Simulator::ticks + SIM_EEPROM_WRITE_TICKS;
+}
+
+void eeprom_update_byte(uint8_t *pos, const uint8_t value) { eeprom_write_byte(pos, value); }
+
+void eeprom_read_block(void *dst, const void *src, size_t n) {
+  for (uint8_t *d = (uint8_t*)dst, *s = (uint8_t*)src; n--;) *d++ = eeprom_read_byte(s++);
+}
+
+void eeprom_update_block(const void *src, void *dst, size_t n) {
+  for (uint8_t *s = (uint8_t*)src, *d = (uint8_t*)dst; n--;) eeprom_write_byte(d++, *s++);
+}
+
+// --------------------------------------------------------------------------
+// Miscellaneous
+// --------------------------------------------------------------------------
+
+TwoWire Wire;
+
+// There is no stack/heap collision to watch for on the host
+int freeMemory() { return 4096; }
+
+static char* sim_utoa(unsigned long value, char *str, int base) {
+  char buf[8 * sizeof(long) + 1], *p = buf + sizeof(buf) - 1;
+  *p = '\0';
+  do {
+    const uint8_t d = value % base;
+    *--p = d < 10 ? '0' + d : 'a' + d - 10;
+    value /= base;
+  } while (value);
+  return strcpy(str, p);
+}
+
+char* ultoa(unsigned long value, char *str, int base) { return sim_utoa(value, str, base); }
+
+char* ltoa(long value, char *str, int base) {
+  if (value < 0 && base == 10) {
+    *str = '-';
+    sim_utoa(-(unsigned long)value, str + 1, base);
+    return str;
+  }
+  return sim_utoa(value, str, base);
+}
+
+char* itoa(int value, char *str, int base) { return ltoa(base == 10 ? (long)value : (long)(unsigned int)value, str, base); }
+
+char* dtostrf(double val, signed char width, unsigned char prec, char *sout) {
+  sprintf(sout, "%*.*f", width, prec, val);
+  return sout;
+}
+
+long random(long max) { return max > 0 ? rand() % max : 0; }
+long random(long min, long max) { return max > min ? min + random(max - min) : min; }
+void randomSeed(unsigned long seed) { srand(seed); }
+
+#endif // __PLAT_LINUX__
@@ -38,7 +38,31 @@
   #include "I2CPositionEncoder.h"
   #include "parser.h"
 
-  #include <Wire.h>
+  #if DISABLED(TWIBUS_ASYNC)
+    #include <Wire.h>
+  #endif
+
+  // Write to a module. With no bytes, just check that it answers.
+  static bool i2cpe_write(const uint8_t address, const byte *src, const uint8_t bytes) {
+    #if ENABLED(TWIBUS_ASYNC)
+      return TWIBus::transfer(address, src, bytes);
+    #else
+      Wire.beginTransmission(address);
+      if (bytes) Wire.write(src, bytes);
+      return !Wire.endTransmission();
+    #endif
+  }
+
+  // Read from a module, returning the number of bytes read
+  static uint8_t i2cpe_read(const uint8_t address, byte *dst, const uint8_t bytes) {
+    #if ENABLED(TWIBUS_ASYNC)
+      return TWIBus::transfer(address, NULL, 0, dst, bytes) ? bytes : 0;
+    #else
+      const uint8_t count = Wire.requestFrom((int)address, (int)bytes);
+      for (uint8_t i = 0; i < count && Wire.available(); i++) dst[i] = (uint8_t)Wire.read();
+      return count;
+    #endif
+  }
 
 
   void I2CPositionEncoder::init(const uint8_t address, const AxisEnum axis) {
@@ -51,12 +75,32 @@
     SERIAL_ECHOLNPAIR(" axis, addr = ", address);
 
     position = get_position();
+    #if ENABLED(TWIBUS_ASYNC)
+      positionSteps = stepper.position(encoderAxis);
+    #endif
   }
 
   void I2CPositionEncoder::update() {
     if (!initialised || !homed || !active) return; //check encoder is set up and active
 
-    position = get_position();
+    #if ENABLED(TWIBUS_ASYNC)
+      // Use the count polled since the last update, if it's in
+      if (!polled) return;
+      polled = false;
+      if (polledOk) {
+        i2cLong encoderCount;
+        encoderCount.val = 0x00;
+        COPY(encoderCount.bval, polledBytes); // Only 3 bytes
+        position = decode_count(encoderCount) - zeroOffset;
+      }
+      else {
+        H = I2CPE_MAG_SIG_NF;
+        position = -zeroOffset;
+      }
+      positionSteps = polledSteps;
+    #else
+      position = get_position();
+    #endif
 
     //we don't want to stop things just because the encoder missed a message,
     //so we only care about responses that indicate bad magnetic strength
@@ -221,6 +265,9 @@
       delay(10);
 
       zeroOffset = get_raw_count();
+      #if ENABLED(TWIBUS_ASYNC)
+        polled = false; // Read before the reset
+      #endif
       homed++;
       trusted++;
 
@@ -289,7 +336,13 @@
     //convert both 'ticks' into same units / base
     encoderCountInStepperTicksScaled = LROUND((stepperTicksPerUnit * encoderTicks) / encoderTicksPerUnit);
 
-    int32_t target = stepper.position(encoderAxis),
+    int32_t target =
+              #if ENABLED(TWIBUS_ASYNC)
+                positionSteps // Where the steppers were when the count was read
+              #else
+                stepper.position(encoderAxis)
+              #endif
+            ,
             error = (encoderCountInStepperTicksScaled - target);
 
     //suppress discontinuities (might be caused by bad I2C readings...?)
@@ -310,20 +363,41 @@
   }
 
   int32_t I2CPositionEncoder::get_raw_count() {
-    uint8_t index = 0;
     i2cLong encoderCount;
 
     encoderCount.val = 0x00;
 
-    if (Wire.requestFrom((int)i2cAddress, 3) != 3) {
+    if (i2cpe_read(i2cAddress, encoderCount.bval, 3) != 3) {
       //houston, we have a problem...
       H = I2CPE_MAG_SIG_NF;
       return 0;
     }
 
-    while (Wire.available())
-      encoderCount.bval[index++] = (uint8_t)Wire.read();
+    return decode_count(encoderCount);
+  }
+
+  #if ENABLED(TWIBUS_ASYNC)
+
+    // Queue a read of the count for the next update()
+    void I2CPositionEncoder::poll(const uint8_t idx) {
+      if (polling || polled || !initialised || !homed || !active) return;
+      polling = true;
+      TWIBus::queue(i2cAddress, NULL, 0, 3, I2CPositionEncodersMgr::poll_done, idx);
+    }
 
+    // Called from the TWI interrupt
+    void I2CPositionEncoder::poll_done(const twi_transaction_t &t) {
+      polledOk = t.ok;
+      COPY(polledBytes, t.data);
+      polledSteps = stepper.position(encoderAxis);
+      polling = false;
+      polled = true;
+    }
+
+  #endif
+
+  // The count and field strength from the 3 bytes a module sends
+  int32_t I2CPositionEncoder::decode_count(i2cLong &encoderCount) {
     //extract the magnetic strength
     H = (B00000011 & (encoderCount.bval[2] >> 6));
 
@@ -474,9 +548,8 @@
   }
 
   void I2CPositionEncoder::reset() {
-    Wire.beginTransmission(i2cAddress);
-    Wire.write(I2CPE_RESET_COUNT);
-    Wire.endTransmission();
+    const byte cmd = I2CPE_RESET_COUNT;
+    i2cpe_write(i2cAddress, &cmd, 1);
 
     #if ENABLED(I2CPE_ERR_ROLLING_AVERAGE)
       ZERO(err);
@@ -490,7 +563,9 @@
   I2CPositionEncoder I2CPositionEncodersMgr::encoders[I2CPE_ENCODER_CNT];
 
   void I2CPositionEncodersMgr::init() {
-    Wire.begin();
+    #if DISABLED(TWIBUS_ASYNC)
+      Wire.begin();
+    #endif
 
     #if I2CPE_ENCODER_CNT > 0
       uint8_t i = 0;
@@ -673,16 +748,14 @@
 
   void I2CPositionEncodersMgr::change_module_address(const uint8_t oldaddr, const uint8_t newaddr) {
     // First check 'new' address is not in use
-    Wire.beginTransmission(newaddr);
-    if (!Wire.endTransmission()) {
+    if (i2cpe_write(newaddr, NULL, 0)) {
       SERIAL_ECHOPAIR("?There is already a device with that address on the I2C bus! (", newaddr);
       SERIAL_ECHOLNPGM(")");
       return;
     }
 
     // Now check that we can find the module on the oldaddr address
-    Wire.beginTransmission(oldaddr);
-    if (Wire.endTransmission()) {
+    if (!i2cpe_write(oldaddr, NULL, 0)) {
       SERIAL_ECHOPAIR("?No module detected at this address! (", oldaddr);
       SERIAL_ECHOLNPGM(")");
       return;
@@ -692,10 +765,8 @@
     SERIAL_ECHOLNPAIR(", changing address to ", newaddr);
 
     // Change the modules address
-    Wire.beginTransmission(oldaddr);
-    Wire.write(I2CPE_SET_ADDR);
-    Wire.write(newaddr);
-    Wire.endTransmission();
+    const byte cmd[] = { I2CPE_SET_ADDR, newaddr };
+    i2cpe_write(oldaddr, cmd, COUNT(cmd));
 
     SERIAL_ECHOLNPGM("Address changed, resetting and waiting for confirmation..");
 
@@ -703,8 +774,7 @@
     safe_delay(I2CPE_REBOOT_TIME);
 
     // Look for the module at the new address.
-    Wire.beginTransmission(newaddr);
-    if (Wire.endTransmission()) {
+    if (!i2cpe_write(newaddr, NULL, 0)) {
       SERIAL_ECHOLNPGM("Address change failed! Check encoder module.");
       return;
     }
@@ -723,8 +793,7 @@
 
   void I2CPositionEncodersMgr::report_module_firmware(const uint8_t address) {
     // First check there is a module
-    Wire.beginTransmission(address);
-    if (Wire.endTransmission()) {
+    if (!i2cpe_write(address, NULL, 0)) {
       SERIAL_ECHOPAIR("?No module detected at this address! (", address);
       SERIAL_ECHOLNPGM(")");
       return;
@@ -733,24 +802,20 @@
     SERIAL_ECHOPAIR("Requesting version info from module at address ", address);
     SERIAL_ECHOLNPGM(":");
 
-    Wire.beginTransmission(address);
-    Wire.write(I2CPE_SET_REPORT_MODE);
-    Wire.write(I2CPE_REPORT_VERSION);
-    Wire.endTransmission();
+    const byte version_mode[] = { I2CPE_SET_REPORT_MODE, I2CPE_REPORT_VERSION };
+    i2cpe_write(address, version_mode, COUNT(version_mode));
 
     // Read value
-    if (Wire.requestFrom((int)address, 32)) {
-      char c;
-      while (Wire.available() > 0 && (c = (char)Wire.read()) > 0)
-        SERIAL_ECHO(c);
+    byte version[32];
+    if (const uint8_t count = i2cpe_read(address, version, COUNT(version))) {
+      for (uint8_t i = 0; i < count && version[i]; i++)
+        SERIAL_ECHO((char)version[i]);
       SERIAL_EOL();
     }
 
     // Set module back to normal (distance) mode
-    Wire.beginTransmission(address);
-    Wire.write(I2CPE_SET_REPORT_MODE);
-    Wire.write(I2CPE_REPORT_DISTANCE);
-    Wire.endTransmission();
+    const byte distance_mode[] = { I2CPE_SET_REPORT_MODE, I2CPE_REPORT_DISTANCE };
+    i2cpe_write(address, distance_mode, COUNT(distance_mode));
   }
 
   int8_t I2CPositionEncodersMgr::parse() {
@@ -30,7 +30,11 @@
   #include "enum.h"
   #include "macros.h"
   #include "types.h"
-  #include <Wire.h>
+  #if ENABLED(TWIBUS_ASYNC)
+    #include "twibus.h"
+  #else
+    #include <Wire.h>
+  #endif
 
   //=========== Advanced / Less-Common Encoder Configuration Settings ==========
 
@@ -140,12 +144,28 @@
           errPrst[I2CPE_ERR_PRST_ARRAY_SIZE] = { 0 };
     #endif
 
+    #if ENABLED(TWIBUS_ASYNC)
+      volatile bool polling           = false,  // A read of the count is queued
+                    polled            = false;  // Its reply is in
+      bool      polledOk;
+      uint8_t   polledBytes[3];
+      int32_t   polledSteps,                    // Stepper position when the count was read
+                positionSteps;                  // Stepper position when 'position' was read
+    #endif
+
+    int32_t decode_count(i2cLong &encoderCount);
+
   public:
     void init(const uint8_t address, const AxisEnum axis);
     void reset();
 
     void update();
 
+    #if ENABLED(TWIBUS_ASYNC)
+      void poll(const uint8_t idx);
+      void poll_done(const twi_transaction_t &t);
+    #endif
+
     void set_homed();
 
     int32_t get_raw_count();
@@ -224,7 +244,18 @@
     static void init(void);
 
     // consider only updating one endoder per call / tick if encoders become too time intensive
-    static void update(void) { LOOP_PE(i) encoders[i].update(); }
+    static void update(void) {
+      LOOP_PE(i) {
+        encoders[i].update();
+        #if ENABLED(TWIBUS_ASYNC)
+          encoders[i].poll(i); // The count for the next update, read while the main loop goes on
+        #endif
+      }
+    }
+
+    #if ENABLED(TWIBUS_ASYNC)
+      static void poll_done(const twi_transaction_t &t) { encoders[t.tag].poll_done(t); }
+    #endif
 
     static void homed(const AxisEnum axis) {
       LOOP_PE(i)
@@ -121,7 +121,12 @@ int16_t count_test_bytes(const char * const ptr) {
       SERIAL_CHAR('|');                   // Point out non test bytes
       for (uint8_t i = 0; i < 16; i++) {
         char ccc = (char)ptr[i]; // cast to char before automatically casting to char on assignment, in case the compiler is broken
-        if (&ptr[i] >= (const char*)command_queue && &ptr[i] < (const char*)(command_queue + sizeof(command_queue))) { // Print out ASCII in the command buffer area
+        #if ENABLED(COMMAND_ARENA)
+          #define COMMAND_BUFFER command_arena
+        #else
+          #define COMMAND_BUFFER command_queue
+        #endif
+        if (&ptr[i] >= (const char*)COMMAND_BUFFER && &ptr[i] < (const char*)COMMAND_BUFFER + sizeof(COMMAND_BUFFER)) { // Print out ASCII in the command buffer area
           if (!WITHIN(ccc, ' ', 0x7E)) ccc = ' ';
         }
         else { // If not in the command buffer area, flag bytes that don't match the test byte
@@ -243,6 +248,14 @@ void gcode_M100() {
   SERIAL_ECHOPAIR("\nstart of free space : ", hex_address(ptr));
   SERIAL_ECHOLNPAIR("\nStack Pointer : ", hex_address(sp));
 
+  #if ENABLED(COMMAND_ARENA)
+    SERIAL_ECHOPAIR("Command arena high-water mark : ", command_arena_high_water);
+    SERIAL_ECHOPAIR(" of ", COMMAND_ARENA_SIZE);
+    SERIAL_ECHOPAIR(" bytes, ", int(most_commands_queued));
+    SERIAL_ECHOPAIR(" of ", COMMAND_ARENA_SLOTS);
+    SERIAL_ECHOLNPGM(" commands");
+  #endif
+
   // Always init on the first invocation of M100
   static bool m100_not_initialized = true;
   if (m100_not_initialized || parser.seen('I')) {
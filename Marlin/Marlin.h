@@ -236,7 +236,16 @@ bool enqueue_and_echo_command(const char* cmd);           // Add a single comman
 void enqueue_and_echo_commands_P(const char * const cmd); // Set one or more commands to be prioritized over the next Serial/SD command.
 void clear_command_queue();
 
-#if ENABLED(M100_FREE_MEMORY_WATCHER) || ENABLED(POWER_LOSS_RECOVERY)
+#if ENABLED(COMMAND_ARENA)
+  #if ENABLED(M100_FREE_MEMORY_WATCHER)
+    extern char command_arena[COMMAND_ARENA_SIZE];
+    extern uint16_t command_arena_high_water;
+    extern uint8_t most_commands_queued;
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    extern uint32_t command_sdpos[COMMAND_SLOTS];
+  #endif
+#elif ENABLED(M100_FREE_MEMORY_WATCHER) || ENABLED(POWER_LOSS_RECOVERY)
   extern char command_queue[BUFSIZE][MAX_CMD_SIZE];
 #endif
 
@@ -427,6 +436,10 @@ void report_current_position();
     LL[D_AXIS] = anchor_D_z;             \
   }while(0)
 
+  #if ENABLED(MECHADUINO_I2C_COMMANDS)
+    float ang_to_mm(float ang, const AxisEnum axis); // Line length from origin for an encoder angle since G96
+  #endif
+
 #elif IS_SCARA
   void forward_kinematics_SCARA(const float &a, const float &b);
 #endif
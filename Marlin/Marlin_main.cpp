@@ -91,7 +91,7 @@
  * M23  - Select SD file: "M23 /path/file.gco". (Requires SDSUPPORT)
  * M24  - Start/resume SD print. (Requires SDSUPPORT)
  * M25  - Pause SD print. (Requires SDSUPPORT)
- * M26  - Set SD position in bytes: "M26 S12345". (Requires SDSUPPORT)
+ * M26  - Set SD position in bytes: "M26 S12345", or to a layer: "M26 L12". (Requires SDSUPPORT, and SD_PRINT_INDEX for layers)
  * M27  - Report SD print status. (Requires SDSUPPORT)
  *        OR, with 'S<seconds>' set the SD status auto-report interval. (Requires AUTO_REPORT_SD_STATUS)
  *        OR, with 'C' get the current filename.
@@ -120,6 +120,8 @@
  * M85  - Set inactivity shutdown timer with parameter S<seconds>. To disable set zero (default)
  * M92  - Set planner.axis_steps_per_mm for one or more axes.
  * M100 - Watch Free Memory (for debugging) (Requires M100_FREE_MEMORY_WATCHER)
+ * M102 - Report the hot path profile, or with S<seconds> auto-report it. (Requires PROFILE_HOT_PATHS)
+ * M103 - Send the line length telemetry, or with S<ms> set its rate. (Requires MECHADUINO_TELEMETRY)
  * M104 - Set extruder target temp.
  * M105 - Report current temperatures.
  * M106 - Set print fan speed.
@@ -298,6 +300,10 @@
   #include "power_loss_recovery.h"
 #endif
 
+#if ENABLED(PROFILE_HOT_PATHS)
+  #include "profiler.h"
+#endif
+
 #if ENABLED(FILAMENT_RUNOUT_SENSOR)
   #include "runout.h"
 #endif
@@ -342,6 +348,10 @@
   #include "I2CPositionEncoder.h"
 #endif
 
+#if ENABLED(MECHADUINO_TELEMETRY)
+  #include "mechaduino_telemetry.h"
+#endif
+
 #if ENABLED(M100_FREE_MEMORY_WATCHER)
   void gcode_M100();
   void M100_dump_routine(const char * const title, const char *start, const char *end);
@@ -414,7 +424,8 @@ static long gcode_N, gcode_LastN, Stopped_gcode_LastN = 0;
 
 /**
  * GCode Command Queue
- * A simple ring buffer of BUFSIZE command strings.
+ * A simple ring buffer of BUFSIZE command strings,
+ * or of COMMAND_ARENA_SLOTS commands with COMMAND_ARENA.
  *
  * Commands are copied into this buffer by the command injectors
  * (immediate, serial, sd card) and they are processed sequentially by
@@ -425,7 +436,27 @@ uint8_t commands_in_queue = 0, // Count of commands in the queue
         cmd_queue_index_r = 0, // Ring buffer read (out) position
         cmd_queue_index_w = 0; // Ring buffer write (in) position
 
-char command_queue[BUFSIZE][MAX_CMD_SIZE];
+#if ENABLED(COMMAND_ARENA)
+  /**
+   * With COMMAND_ARENA the commands are stored end to end in one byte
+   * arena, each slot holding the offset of its command. A command is
+   * read in wherever MAX_CMD_SIZE contiguous bytes are free, then only
+   * its actual length is kept, so short commands take up little room.
+   */
+  char command_arena[COMMAND_ARENA_SIZE];
+  uint16_t command_offset[COMMAND_SLOTS];
+  #if ENABLED(M100_FREE_MEMORY_WATCHER)
+    uint16_t command_arena_high_water; // Most arena bytes in use
+    uint8_t most_commands_queued;      // Most commands in the queue
+  #endif
+  #if ENABLED(POWER_LOSS_RECOVERY)
+    uint32_t command_sdpos[COMMAND_SLOTS]; // SD position + 1 of commands read from SD, else 0
+  #endif
+  #define QUEUED_COMMAND(I) (command_arena + command_offset[I])
+#else
+  char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  #define QUEUED_COMMAND(I) command_queue[I]
+#endif
 
 /**
  * Next Injected Command pointer. NULL if no commands are being injected.
@@ -536,6 +567,13 @@ const char axis_codes[XYZE] = { 'X', 'Y', 'Z', 'E' };
 // Number of characters read in the current line of serial input
 static int serial_count; // = 0;
 
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  // Length of the binary frame being read, 0 when reading ASCII
+  static uint8_t binary_frame_length; // = 0
+  #define BINARY_FRAME_DROP 0xFE      // A frame failed. Drop input until the host goes quiet.
+  static millis_t binary_frame_ms;    // Time of the last byte read for a frame
+#endif
+
 // Inactivity shutdown
 millis_t previous_move_ms; // = 0;
 static millis_t max_inactive_time; // = 0;
@@ -663,6 +701,8 @@ uint8_t target_extruder;
     #define ABL_BG_POINTS_Y   GRID_MAX_POINTS_Y
     #define ABL_BG_GRID(X,Y)  z_values[X][Y]
   #endif
+  // Whole grid units of the grid box cached by bilinear_z_offset. NAN to find the box again.
+  static float boxx = NAN, boxy = NAN;
 #endif
 
 #if IS_SCARA
@@ -699,7 +739,7 @@ float cartes[XYZ] = { 0 };
   #endif
 #endif
 
-static bool send_ok[BUFSIZE];
+static bool send_ok[COMMAND_SLOTS];
 
 #if HAS_SERVOS
   Servo servo[NUM_SERVOS];
@@ -821,6 +861,8 @@ void sync_plan_position_e() { planner.set_e_position_mm(current_position[E_CART]
 #if ENABLED(SDSUPPORT)
   #include "SdFatUtil.h"
   int freeMemory() { return SdFatUtil::FreeRam(); }
+#elif defined(__PLAT_LINUX__)
+  int freeMemory(); // Provided by the simulator, see HAL_LINUX
 #else
 extern "C" {
   extern char __bss_end;
@@ -876,15 +918,74 @@ void enqueue_and_echo_commands_P(const char * const pgcode) {
  */
 void clear_command_queue() {
   cmd_queue_index_r = cmd_queue_index_w = commands_in_queue = 0;
+  #if ENABLED(COMMAND_ARENA) && ENABLED(POWER_LOSS_RECOVERY)
+    command_sdpos[0] = 0;
+  #endif
 }
 
+#if ENABLED(COMMAND_ARENA)
+
+  /**
+   * Return true if a command of up to MAX_CMD_SIZE bytes can be written
+   * at the write position, moving the write position to the start of
+   * the arena when the end is too short. The result only changes when
+   * a command is committed or dequeued, so a command read in over many
+   * calls always stays in one place.
+   */
+  bool queue_has_room() {
+    if (commands_in_queue >= COMMAND_SLOTS) return false;
+    uint16_t &tail = command_offset[cmd_queue_index_w];
+    if (!commands_in_queue) { tail = 0; return true; }
+    const uint16_t head = command_offset[cmd_queue_index_r];
+    if (tail > head) {                                          // In use: head...tail
+      if (tail + (MAX_CMD_SIZE) <= COMMAND_ARENA_SIZE) return true;
+      if (head < MAX_CMD_SIZE) return false;
+      tail = 0;                                                 // Wrap around
+      return true;
+    }
+    return tail + (MAX_CMD_SIZE) <= head;                       // In use: head...end, 0...tail
+  }
+
+#else
+
+  FORCE_INLINE bool queue_has_room() { return commands_in_queue < BUFSIZE; }
+
+#endif
+
 /**
  * Once a new command is in the ring buffer, call this to commit it
  */
 inline void _commit_command(bool say_ok) {
+  char * const cmd = QUEUED_COMMAND(cmd_queue_index_w);
+  #if ENABLED(PARSED_COMMAND_QUEUE)
+    parser.pack(cmd);
+  #endif
   send_ok[cmd_queue_index_w] = say_ok;
-  if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
-  commands_in_queue++;
+  #if ENABLED(COMMAND_ARENA)
+    // The next command starts right after this one
+    const uint16_t end = command_offset[cmd_queue_index_w] + (
+      #if HAS_PACKED_COMMANDS
+        *cmd == PACKED_COMMAND_MARK ? parser.packed_length(cmd) :
+      #endif
+      strlen(cmd) + 1
+    );
+    if (++cmd_queue_index_w >= COMMAND_SLOTS) cmd_queue_index_w = 0;
+    command_offset[cmd_queue_index_w] = end;
+    #if ENABLED(POWER_LOSS_RECOVERY)
+      command_sdpos[cmd_queue_index_w] = 0;
+    #endif
+    commands_in_queue++;
+    #if ENABLED(M100_FREE_MEMORY_WATCHER)
+      const uint16_t head = command_offset[cmd_queue_index_r],
+                     used = end > head ? end - head : COMMAND_ARENA_SIZE - head + end;
+      NOLESS(command_arena_high_water, used);
+      NOLESS(most_commands_queued, commands_in_queue);
+    #endif
+  #else
+    UNUSED(cmd);
+    if (++cmd_queue_index_w >= BUFSIZE) cmd_queue_index_w = 0;
+    commands_in_queue++;
+  #endif
 }
 
 /**
@@ -893,8 +994,8 @@ inline void _commit_command(bool say_ok) {
  * Return false for a full buffer, or if the 'command' is a comment.
  */
 inline bool _enqueuecommand(const char* cmd, bool say_ok=false) {
-  if (*cmd == ';' || commands_in_queue >= BUFSIZE) return false;
-  strcpy(command_queue[cmd_queue_index_w], cmd);
+  if (*cmd == ';' || !queue_has_room()) return false;
+  strcpy(QUEUED_COMMAND(cmd_queue_index_w), cmd);
   _commit_command(say_ok);
   return true;
 }
@@ -1011,8 +1112,80 @@ void gcode_line_error(const char* err, bool doFlush = true) {
   //Serial.println(gcode_N);
   if (doFlush) flush_and_request_resend();
   serial_count = 0;
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    binary_frame_length = 0;
+  #endif
 }
 
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+
+  FORCE_INLINE int32_t frame_long(const uint8_t * const p) {
+    return (int32_t)(p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24);
+  }
+
+  /**
+   * Report a bad binary frame. The rest of the frame and any frames
+   * the host sent after it are dropped, then get_serial_commands()
+   * requests the resend once the host has gone quiet.
+   */
+  void binary_frame_error(const char* err) {
+    gcode_line_error(err, false);
+    binary_frame_length = BINARY_FRAME_DROP;
+  }
+
+  /**
+   * Check a complete binary frame and queue it (see BINARY_GCODE_PROTOCOL)
+   * The queued command is packed, so parser.parse() reads the values as they came.
+   */
+  inline void queue_binary_frame(const uint8_t * const frame) {
+    const uint8_t len = binary_frame_length;
+    binary_frame_length = serial_count = 0;
+
+    uint16_t crc = 0;
+    crc16(&crc, frame + 1, len - 3);
+    if (crc != (frame[len - 2] | (uint16_t)frame[len - 1] << 8))
+      return binary_frame_error(PSTR(MSG_ERR_CHECKSUM_MISMATCH));
+
+    // Only moves. Other commands would run with packed move values.
+    if (frame[1] > 3) return binary_frame_error(PSTR(MSG_ERR_BINARY_CODE));
+
+    gcode_N = gcode_LastN + 1;
+    if ((uint16_t)gcode_N != (frame[3] | (uint16_t)frame[4] << 8))
+      return binary_frame_error(PSTR(MSG_ERR_LINE_NO));
+
+    #if ENABLED(SDSUPPORT)
+      if (card.saving) return binary_frame_error(PSTR(MSG_ERR_BINARY_SD_SAVE));
+    #endif
+
+    char * const cmd = QUEUED_COMMAND(cmd_queue_index_w), *p = cmd + PACKED_HEADER_SIZE;
+    cmd[0] = PACKED_COMMAND_MARK;
+    cmd[1] = 'G';
+    cmd[2] = frame[1];
+    cmd[3] = cmd[4] = cmd[5] = 0;
+    const uint8_t *v = frame + 5;
+    for (uint8_t i = 0; i < COUNT(BINARY_WORDS) - 1; i++)
+      if (TEST(frame[2], i)) {
+        parser.pack_param(p, LETTER_BIT(BINARY_WORDS[i]), frame_long(v), 3);
+        v += 4;
+        cmd[5]++;
+      }
+
+    // Queued commands must fit MAX_CMD_SIZE as text, e.g., for M111 S1 and power-loss recovery
+    if (parser.unpack(NULL, cmd, 0) >= MAX_CMD_SIZE) return binary_frame_error(PSTR(MSG_ERR_BINARY_LONG));
+
+    gcode_LastN = gcode_N;
+
+    // Movement commands alert when stopped
+    if (IsStopped()) {
+      SERIAL_ERRORLNPGM(MSG_ERR_STOPPED);
+      LCD_MESSAGEPGM(MSG_STOPPED);
+    }
+
+    _commit_command(true);
+  }
+
+#endif // BINARY_GCODE_PROTOCOL
+
 /**
  * Get all commands waiting on the serial port and queue them.
  * Exit when the buffer is full or when no more characters are
@@ -1033,11 +1206,47 @@ inline void get_serial_commands() {
     }
   #endif
 
+  #if ENABLED(BINARY_GCODE_PROTOCOL)
+    /**
+     * When the host goes quiet partway through a frame (e.g., a lost byte)
+     * or after a bad frame, request a resend of the frame
+     */
+    if (binary_frame_length && !MYSERIAL0.available() && ELAPSED(millis(), binary_frame_ms + BINARY_FRAME_TIMEOUT)) {
+      if (binary_frame_length == BINARY_FRAME_DROP) {
+        binary_frame_length = serial_count = 0;
+        flush_and_request_resend();
+      }
+      else
+        gcode_line_error(PSTR(MSG_ERR_BINARY_TIMEOUT));
+    }
+  #endif
+
   /**
    * Loop while serial characters are incoming and the queue is not full
    */
   int c;
-  while (commands_in_queue < BUFSIZE && (c = MYSERIAL0.read()) >= 0) {
+  while (queue_has_room() && (c = MYSERIAL0.read()) >= 0) {
+
+    #if ENABLED(BINARY_GCODE_PROTOCOL)
+      /**
+       * A sync byte in place of the first character starts a binary frame.
+       * Its length is known once the words mask (third byte) has arrived.
+       */
+      if (binary_frame_length || (c == BINARY_FRAME_SYNC && !serial_count && !serial_comment_mode)) {
+        binary_frame_ms = millis();
+        if (binary_frame_length == BINARY_FRAME_DROP) continue;
+        serial_line_buffer[serial_count++] = c;
+        if (serial_count == 1)
+          binary_frame_length = 0xFF;
+        else if (serial_count == 3) {
+          binary_frame_length = 7;
+          for (uint8_t w = c; w; w >>= 1) if (w & 1) binary_frame_length += 4;
+        }
+        else if (serial_count == binary_frame_length)
+          queue_binary_frame((uint8_t*)serial_line_buffer);
+        continue;
+      }
+    #endif
 
     char serial_char = c;
 
@@ -1159,8 +1368,7 @@ inline void get_serial_commands() {
    * can also interrupt buffering.
    */
   inline void get_sdcard_commands() {
-    static bool stop_buffering = false,
-                sd_comment_mode = false;
+    static bool stop_buffering = false;
 
     if (!card.sdprinting) return;
 
@@ -1173,70 +1381,63 @@ inline void get_serial_commands() {
 
     if (commands_in_queue == 0) stop_buffering = false;
 
-    uint16_t sd_count = 0;
-    bool card_eof = card.eof();
-    while (commands_in_queue < BUFSIZE && !card_eof && !stop_buffering) {
-      const int16_t n = card.get();
-      char sd_char = (char)n;
-      card_eof = card.eof();
-      if (card_eof || n == -1
-          || sd_char == '\n' || sd_char == '\r'
-          || ((sd_char == '#' || sd_char == ':') && !sd_comment_mode)
-      ) {
-        if (card_eof) {
+    while (queue_has_room() && !card.eof() && !stop_buffering) {
+      #if (ENABLED(COMMAND_ARENA) && ENABLED(POWER_LOSS_RECOVERY)) || ENABLED(SD_PRINT_INDEX)
+        const uint32_t sd_line_pos = card.getIndex();
+      #endif
+      char sd_char;
+      const int16_t sd_count = card.get_line(QUEUED_COMMAND(cmd_queue_index_w), MAX_CMD_SIZE, sd_char);
+      if (sd_count < 0) {
+        SERIAL_ERROR_START();
+        SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
+        break;
+      }
 
-          card.printingHasFinished();
+      if (card.eof()) {
 
-          if (card.sdprinting)
-            sd_count = 0; // If a sub-file was printing, continue from call point
-          else {
-            SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
-            #if ENABLED(PRINTER_EVENT_LEDS)
-              LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
-              leds.set_green();
-              #if HAS_RESUME_CONTINUE
-                lights_off_after_print = true;
-                enqueue_and_echo_commands_P(PSTR("M0 S"
-                  #if ENABLED(NEWPANEL)
-                    "1800"
-                  #else
-                    "60"
-                  #endif
-                ));
-              #else
-                safe_delay(2000);
-                leds.set_off();
-              #endif
-            #endif // PRINTER_EVENT_LEDS
-          }
-        }
-        else if (n == -1) {
-          SERIAL_ERROR_START();
-          SERIAL_ECHOLNPGM(MSG_SD_ERR_READ);
+        card.printingHasFinished();
+
+        if (!card.sdprinting) {
+          SERIAL_PROTOCOLLNPGM(MSG_FILE_PRINTED);
+          #if ENABLED(PRINTER_EVENT_LEDS)
+            LCD_MESSAGEPGM(MSG_INFO_COMPLETED_PRINTS);
+            leds.set_green();
+            #if HAS_RESUME_CONTINUE
+              lights_off_after_print = true;
+              enqueue_and_echo_commands_P(PSTR("M0 S"
+                #if ENABLED(NEWPANEL)
+                  "1800"
+                #else
+                  "60"
+                #endif
+              ));
+            #else
+              safe_delay(2000);
+              leds.set_off();
+            #endif
+          #endif // PRINTER_EVENT_LEDS
         }
-        if (sd_char == '#') stop_buffering = true;
+      }
 
-        sd_comment_mode = false; // for new command
+      if (sd_char == '#') stop_buffering = true;
 
-        // Skip empty lines and comments
-        if (!sd_count) { thermalManager.manage_heater(); continue; }
+      // Skip empty lines and comments
+      if (!sd_count) { thermalManager.manage_heater(); continue; }
 
-        command_queue[cmd_queue_index_w][sd_count] = '\0'; // terminate string
-        sd_count = 0; // clear sd line buffer
+      #if ENABLED(COMMAND_ARENA) && ENABLED(POWER_LOSS_RECOVERY)
+        command_sdpos[cmd_queue_index_w] = sd_line_pos + 1;
+      #endif
+      #if ENABLED(SD_PRINT_INDEX)
+        card.index_command(QUEUED_COMMAND(cmd_queue_index_w), sd_line_pos);
+      #endif
 
-        _commit_command(false);
-      }
-      else if (sd_count >= MAX_CMD_SIZE - 1) {
-        /**
-         * Keep fetching, but ignore normal characters beyond the max length
-         * The command will be injected when EOL is reached
-         */
-      }
-      else {
-        if (sd_char == ';') sd_comment_mode = true;
-        if (!sd_comment_mode) command_queue[cmd_queue_index_w][sd_count++] = sd_char;
-      }
+      _commit_command(false);
     }
+
+    #if ENABLED(SD_READ_AHEAD)
+      // Read the next block while the queue is full
+      if (card.sdprinting) card.readAhead();
+    #endif
   }
 
   #if ENABLED(POWER_LOSS_RECOVERY)
@@ -2766,8 +2967,7 @@ void clean_up_after_endstop_or_probe_move() {
 
         #if ENABLED(AUTO_BED_LEVELING_BILINEAR)
           // Force bilinear_z_offset to re-calculate next time
-          const float reset[XYZ] = { -9999.999, -9999.999, 0 };
-          (void)bilinear_z_offset(reset);
+          boxx = boxy = NAN;
         #endif
 
         // Enable or disable leveling compensation in the planner
@@ -3122,6 +3322,8 @@ void clean_up_after_endstop_or_probe_move() {
     #if ENABLED(ABL_BILINEAR_SUBDIVISION)
       bed_level_virt_interpolate();
     #endif
+    // Force bilinear_z_offset to re-calculate the grid box
+    boxx = boxy = NAN;
   }
 
 #endif // AUTO_BED_LEVELING_BILINEAR
@@ -6826,42 +7028,33 @@ inline void gcode_G92() {
       #endif
     ;
     const float c = abs_step_in_origin + ang * float(STEPS_PER_MOTOR_REVOLUTION) / 360.0; // current step count
-    return
-      #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
-        // Inverse function found in planner.cpp, where target[AXIS_A] is calculated
-        ((c / planner.k0[axis] + planner.sqrtk1[axis]) * (c / planner.k0[axis] + planner.sqrtk1[axis]) - planner.k1[axis]) / planner.k2[axis] - line_lengths_origin[axis]
-      #else
-        c / planner.axis_steps_per_mm[axis] - line_lengths_origin[axis]
-      #endif
-    ;
+    return planner.axis_steps_to_mm(axis, c) - line_lengths_origin[axis];
   }
 
   void report_axis_position_from_encoder_data() {
-    i2cFloat ang;
+    // Read them all before printing, as a read may call idle()
+    i2cFloat ang[NUM_AXIS] = { { 0 } };
+    bool got[NUM_AXIS] = { false };
 
     #define M114_S1_RECEIVE(LETTER) do { \
       i2c.address(LETTER##_MOTOR_I2C_ADDR); \
       i2c.request(sizeof(float)); \
-      i2c.capture(ang.bval, sizeof(float)); \
-      if(LETTER##_INVERT_REPORTED_ANGLE == INVERT_##LETTER##_DIR) ang.fval = -ang.fval; \
-      SERIAL_PROTOCOL(ang_to_mm(ang.fval, LETTER##_AXIS)); \
+      i2c.capture(ang[LETTER##_AXIS].bval, sizeof(float)); \
+      if(LETTER##_INVERT_REPORTED_ANGLE == INVERT_##LETTER##_DIR) ang[LETTER##_AXIS].fval = -ang[LETTER##_AXIS].fval; \
+      got[LETTER##_AXIS] = true; \
     } while(0)
 
-    SERIAL_CHAR('[');
     #if ENABLED(HANGPRINTER)
       #if ENABLED(A_IS_MECHADUINO)
         M114_S1_RECEIVE(A);
       #endif
       #if ENABLED(B_IS_MECHADUINO)
-        SERIAL_PROTOCOLPGM(", ");
         M114_S1_RECEIVE(B);
       #endif
       #if ENABLED(C_IS_MECHADUINO)
-        SERIAL_PROTOCOLPGM(", ");
         M114_S1_RECEIVE(C);
       #endif
       #if ENABLED(D_IS_MECHADUINO)
-        SERIAL_PROTOCOLPGM(", ");
         M114_S1_RECEIVE(D);
       #endif
     #else
@@ -6869,14 +7062,20 @@ inline void gcode_G92() {
         M114_S1_RECEIVE(X);
       #endif
       #if ENABLED(Y_IS_MECHADUINO)
-        SERIAL_PROTOCOLPGM(", ");
         M114_S1_RECEIVE(Y);
       #endif
       #if ENABLED(Z_IS_MECHADUINO)
-        SERIAL_PROTOCOLPGM(", ");
         M114_S1_RECEIVE(Z);
       #endif
     #endif
+
+    SERIAL_CHAR('[');
+    bool first = true;
+    LOOP_NUM_AXIS(i) if (got[i]) {
+      if (!first) SERIAL_PROTOCOLPGM(", ");
+      first = false;
+      SERIAL_PROTOCOL(ang_to_mm(ang[i].fval, (AxisEnum)i));
+    }
     SERIAL_CHAR(']');
     SERIAL_EOL();
   }
@@ -7646,10 +7845,20 @@ inline void gcode_M17() {
 
   /**
    * M26: Set SD Card file index
+   *
+   *  S<byte>  - Position in the file
+   *  L<layer> - Start of a layer, with a complete index (Requires SD_PRINT_INDEX)
    */
   inline void gcode_M26() {
-    if (card.cardOK && parser.seenval('S'))
+    if (!card.cardOK) return;
+    if (parser.seenval('S'))
       card.setIndex(parser.value_long());
+    #if ENABLED(SD_PRINT_INDEX)
+      else if (parser.seenval('L') && !card.seek_layer(parser.value_ushort())) {
+        SERIAL_ERROR_START();
+        SERIAL_ERRORLNPGM("No such layer in the index.");
+      }
+    #endif
   }
 
   /**
@@ -8491,6 +8700,38 @@ inline void gcode_M105() {
 
 #endif // AUTO_REPORT_TEMPERATURES
 
+#if ENABLED(PROFILE_HOT_PATHS)
+
+  /**
+   * M102: Report the hot path profile since the last report
+   *
+   *  S<seconds> - Auto-report the profile at this interval instead. S0 to stop.
+   */
+  inline void gcode_M102() {
+    if (parser.seenval('S'))
+      profiler.set_auto_report_interval(parser.value_byte());
+    else
+      profiler.report();
+  }
+
+#endif // PROFILE_HOT_PATHS
+
+#if ENABLED(MECHADUINO_TELEMETRY)
+
+  /**
+   * M103: Send the line length telemetry sampled since the last M103, as a binary frame
+   *
+   *  S<ms> - Sample every <ms> milliseconds instead. S0 to stop.
+   */
+  inline void gcode_M103() {
+    if (parser.seenval('S'))
+      mechaduino_telemetry.interval_ms = parser.value_ushort();
+    else
+      mechaduino_telemetry.send_frame();
+  }
+
+#endif // MECHADUINO_TELEMETRY
+
 #if FAN_COUNT > 0
 
   /**
@@ -9452,6 +9693,13 @@ inline void gcode_M115() {
       #endif
     );
 
+    // BINARY_GCODE (G0-G3 as binary frames)
+    cap_line(PSTR("BINARY_GCODE")
+      #if ENABLED(BINARY_GCODE_PROTOCOL)
+        , true
+      #endif
+    );
+
   #endif // EXTENDED_CAPABILITIES_REPORT
 }
 
@@ -9888,6 +10136,10 @@ inline void gcode_M205() {
     if (parser.seen('P')) anchor_D_z                = parser.value_float();
     if (parser.seen('S')) delta_segments_per_second = parser.value_float();
     recalc_hangprinter_settings();
+    #if ENABLED(LINE_BUILDUP_TABLE)
+      SERIAL_ECHO_START();
+      SERIAL_ECHOLNPAIR("Line buildup table error (steps): ", planner.buildup_table_error);
+    #endif
   }
 
 #elif ENABLED(X_DUAL_ENDSTOPS) || ENABLED(Y_DUAL_ENDSTOPS) || ENABLED(Z_DUAL_ENDSTOPS)
@@ -10881,9 +11133,7 @@ void quickstop_stepper() {
     }
     else {
       z_values[ix][iy] = parser.value_linear_units() + (hasQ ? z_values[ix][iy] : 0);
-      #if ENABLED(ABL_BILINEAR_SUBDIVISION)
-        bed_level_virt_interpolate();
-      #endif
+      refresh_bed_level();
     }
   }
 
@@ -12989,6 +13239,14 @@ void process_parsed_command() {
         case 100: gcode_M100(); break;                            // M100: Free Memory Report
       #endif
 
+      #if ENABLED(PROFILE_HOT_PATHS)
+        case 102: gcode_M102(); break;                            // M102: Report Hot Path Profile
+      #endif
+
+      #if ENABLED(MECHADUINO_TELEMETRY)
+        case 103: gcode_M103(); break;                            // M103: Line Length Telemetry
+      #endif
+
       case 104: gcode_M104(); break;                              // M104: Set Hotend Temperature
       case 110: gcode_M110(); break;                              // M110: Set Current Line Number
       case 111: gcode_M111(); break;                              // M111: Set Debug Flags
@@ -13305,14 +13563,28 @@ void process_parsed_command() {
 }
 
 void process_next_command() {
-  char * const current_command = command_queue[cmd_queue_index_r];
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_PROCESS_COMMAND);
+  #endif
+
+  char * const current_command = QUEUED_COMMAND(cmd_queue_index_r);
 
   if (DEBUGGING(ECHO)) {
     SERIAL_ECHO_START();
-    SERIAL_ECHOLN(current_command);
+    #if HAS_PACKED_COMMANDS
+      char text[MAX_CMD_SIZE];
+      parser.unpack(text, current_command, sizeof(text));
+      SERIAL_ECHOLN(text);
+    #else
+      SERIAL_ECHOLN(current_command);
+    #endif
     #if ENABLED(M100_FREE_MEMORY_WATCHER)
       SERIAL_ECHOPAIR("slot:", cmd_queue_index_r);
-      M100_dump_routine("   Command Queue:", (const char*)command_queue, (const char*)(command_queue + sizeof(command_queue)));
+      #if ENABLED(COMMAND_ARENA)
+        M100_dump_routine("   Command Arena:", command_arena, command_arena + sizeof(command_arena));
+      #else
+        M100_dump_routine("   Command Queue:", (const char*)command_queue, (const char*)(command_queue + sizeof(command_queue)));
+      #endif
     #endif
   }
 
@@ -13346,7 +13618,15 @@ void ok_to_send() {
   if (!send_ok[cmd_queue_index_r]) return;
   SERIAL_PROTOCOLPGM(MSG_OK);
   #if ENABLED(ADVANCED_OK)
-    char* p = command_queue[cmd_queue_index_r];
+    char* p = QUEUED_COMMAND(cmd_queue_index_r);
+    #if ENABLED(PARSED_COMMAND_QUEUE)
+      if (*p == PACKED_COMMAND_MARK && p[5] && (p[PACKED_HEADER_SIZE] & 0x1F) == PACKED_LINE_NUMBER) {
+        uint8_t decimals;
+        SERIAL_PROTOCOLPGM(" N");
+        SERIAL_PROTOCOL(parser.packed_value(p + PACKED_HEADER_SIZE, decimals));
+      }
+      else
+    #endif
     if (*p == 'N') {
       SERIAL_PROTOCOL(' ');
       SERIAL_ECHO(*p++);
@@ -13354,7 +13634,7 @@ void ok_to_send() {
         SERIAL_ECHO(*p++);
     }
     SERIAL_PROTOCOLPGM(" P"); SERIAL_PROTOCOL(int(BLOCK_BUFFER_SIZE - planner.movesplanned() - 1));
-    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(BUFSIZE - commands_in_queue);
+    SERIAL_PROTOCOLPGM(" B"); SERIAL_PROTOCOL(COMMAND_SLOTS - commands_in_queue);
   #endif
   SERIAL_EOL();
 }
@@ -13405,16 +13685,8 @@ void ok_to_send() {
   // Get the Z adjustment for non-linear bed leveling
   float bilinear_z_offset(const float raw[XYZ]) {
 
-    static float z1, d2, z3, d4, L, D, ratio_x, ratio_y,
-                 last_x = -999.999, last_y = -999.999;
-
-    // Whole units for the grid line indices. Constrained within bounds.
-    static int8_t gridx, gridy, nextx, nexty,
-                  last_gridx = -99, last_gridy = -99;
-
-    // XY relative to the probed area
-    const float rx = raw[X_AXIS] - bilinear_start[X_AXIS],
-                ry = raw[Y_AXIS] - bilinear_start[Y_AXIS];
+    // Coefficients of the last grid box, with the offset at a + b * ratio_x + (c + d * ratio_x) * ratio_y
+    static float a, b, c, d;
 
     #if ENABLED(EXTRAPOLATE_BEYOND_GRID)
       // Keep using the last grid box
@@ -13424,75 +13696,66 @@ void ok_to_send() {
       #define FAR_EDGE_OR_BOX 1
     #endif
 
-    if (last_x != rx) {
-      last_x = rx;
-      ratio_x = rx * ABL_BG_FACTOR(X_AXIS);
-      const float gx = constrain(FLOOR(ratio_x), 0, ABL_BG_POINTS_X - FAR_EDGE_OR_BOX);
-      ratio_x -= gx;      // Subtract whole to get the ratio within the grid box
+    // XY relative to the probed area, in grid units
+    const float gx = (raw[X_AXIS] - bilinear_start[X_AXIS]) * ABL_BG_FACTOR(X_AXIS),
+                gy = (raw[Y_AXIS] - bilinear_start[Y_AXIS]) * ABL_BG_FACTOR(Y_AXIS);
+
+    // The ratios within the last grid box. Find the box again only if XY has left it.
+    float ratio_x = gx - boxx, ratio_y = gy - boxy;
+    bool new_box = false;
+
+    if (!(ratio_x >= 0 && ratio_x < 1)) {
+      const float bx = constrain(FLOOR(gx), 0, ABL_BG_POINTS_X - FAR_EDGE_OR_BOX);
+      ratio_x = gx - bx;    // Subtract whole to get the ratio within the grid box
 
       #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
         // Beyond the grid maintain height at grid edges
         NOLESS(ratio_x, 0); // Never < 0.0. (> 1.0 is ok when nextx==gridx.)
       #endif
 
-      gridx = gx;
-      nextx = MIN(gridx + 1, ABL_BG_POINTS_X - 1);
+      if (bx != boxx) { boxx = bx; new_box = true; }
     }
 
-    if (last_y != ry || last_gridx != gridx) {
-
-      if (last_y != ry) {
-        last_y = ry;
-        ratio_y = ry * ABL_BG_FACTOR(Y_AXIS);
-        const float gy = constrain(FLOOR(ratio_y), 0, ABL_BG_POINTS_Y - FAR_EDGE_OR_BOX);
-        ratio_y -= gy;
-
-        #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
-          // Beyond the grid maintain height at grid edges
-          NOLESS(ratio_y, 0); // Never < 0.0. (> 1.0 is ok when nexty==gridy.)
-        #endif
-
-        gridy = gy;
-        nexty = MIN(gridy + 1, ABL_BG_POINTS_Y - 1);
-      }
+    if (!(ratio_y >= 0 && ratio_y < 1)) {
+      const float by = constrain(FLOOR(gy), 0, ABL_BG_POINTS_Y - FAR_EDGE_OR_BOX);
+      ratio_y = gy - by;
 
-      if (last_gridx != gridx || last_gridy != gridy) {
-        last_gridx = gridx;
-        last_gridy = gridy;
-        // Z at the box corners
-        z1 = ABL_BG_GRID(gridx, gridy);       // left-front
-        d2 = ABL_BG_GRID(gridx, nexty) - z1;  // left-back (delta)
-        z3 = ABL_BG_GRID(nextx, gridy);       // right-front
-        d4 = ABL_BG_GRID(nextx, nexty) - z3;  // right-back (delta)
-      }
+      #if DISABLED(EXTRAPOLATE_BEYOND_GRID)
+        // Beyond the grid maintain height at grid edges
+        NOLESS(ratio_y, 0); // Never < 0.0. (> 1.0 is ok when nexty==gridy.)
+      #endif
 
-      // Bilinear interpolate. Needed since ry or gridx has changed.
-                  L = z1 + d2 * ratio_y;   // Linear interp. LF -> LB
-      const float R = z3 + d4 * ratio_y;   // Linear interp. RF -> RB
+      if (by != boxy) { boxy = by; new_box = true; }
+    }
 
-      D = R - L;
+    if (new_box) {
+      const int8_t gridx = boxx, gridy = boxy,
+                   nextx = MIN(gridx + 1, ABL_BG_POINTS_X - 1),
+                   nexty = MIN(gridy + 1, ABL_BG_POINTS_Y - 1);
+      // Z at the box corners
+      a = ABL_BG_GRID(gridx, gridy);              // left-front
+      b = ABL_BG_GRID(nextx, gridy) - a;          // right-front (delta)
+      c = ABL_BG_GRID(gridx, nexty) - a;          // left-back (delta)
+      d = ABL_BG_GRID(nextx, nexty) - a - b - c;  // right-back (delta from the plane of the others)
     }
 
-    const float offset = L + ratio_x * D;   // the offset almost always changes
+    // Bilinear interpolate
+    const float offset = a + b * ratio_x + (c + d * ratio_x) * ratio_y;
 
     /*
     static float last_offset = 0;
     if (ABS(last_offset - offset) > 0.2) {
       SERIAL_ECHOPGM("Sudden Shift at ");
-      SERIAL_ECHOPAIR("x=", rx);
-      SERIAL_ECHOPAIR(" / ", bilinear_grid_spacing[X_AXIS]);
-      SERIAL_ECHOLNPAIR(" -> gridx=", gridx);
-      SERIAL_ECHOPAIR(" y=", ry);
-      SERIAL_ECHOPAIR(" / ", bilinear_grid_spacing[Y_AXIS]);
-      SERIAL_ECHOLNPAIR(" -> gridy=", gridy);
+      SERIAL_ECHOPAIR("x=", gx);
+      SERIAL_ECHOLNPAIR(" -> gridx=", boxx);
+      SERIAL_ECHOPAIR(" y=", gy);
+      SERIAL_ECHOLNPAIR(" -> gridy=", boxy);
       SERIAL_ECHOPAIR(" ratio_x=", ratio_x);
       SERIAL_ECHOLNPAIR(" ratio_y=", ratio_y);
-      SERIAL_ECHOPAIR(" z1=", z1);
-      SERIAL_ECHOPAIR(" z2=", z2);
-      SERIAL_ECHOPAIR(" z3=", z3);
-      SERIAL_ECHOLNPAIR(" z4=", z4);
-      SERIAL_ECHOPAIR(" L=", L);
-      SERIAL_ECHOPAIR(" R=", R);
+      SERIAL_ECHOPAIR(" a=", a);
+      SERIAL_ECHOPAIR(" b=", b);
+      SERIAL_ECHOPAIR(" c=", c);
+      SERIAL_ECHOLNPAIR(" d=", d);
       SERIAL_ECHOLNPAIR(" offset=", offset);
     }
     last_offset = offset;
@@ -13721,6 +13984,22 @@ void ok_to_send() {
       }
       planner.axis_steps_per_mm[E_AXIS] = DEFAULT_E_AXIS_STEPS_PER_UNIT;
 
+      #if ENABLED(LINE_BUILDUP_TABLE)
+        // Tabulate up to the longest line lengths, found at the corners of the print volume
+        const float r = HANGPRINTER_PRINTABLE_RADIUS;
+        float max_length[MOV_AXIS] = { 0 };
+        for (uint8_t corner = 0; corner < 8; corner++) {
+          const float pos[XYZ] = {
+            TEST(corner, 0) ? r : -r,
+            TEST(corner, 1) ? r : -r,
+            TEST(corner, 2) ? anchor_D_z : 0
+          };
+          HANGPRINTER_IK(pos);
+          LOOP_MOV_AXIS(i) NOLESS(max_length[i], line_lengths[i]);
+        }
+        planner.refresh_buildup_table(max_length);
+      #endif
+
     #endif // LINE_BUILDUP_COMPENSATION_FEATURE
 
     SYNC_PLAN_POSITION_KINEMATIC(); // recalcs line lengths in case anchor was moved
@@ -13733,6 +14012,107 @@ void ok_to_send() {
     HANGPRINTER_IK(raw);
   }
 
+  #if ENABLED(HANGPRINTER_INCREMENTAL_IK)
+
+    /**
+     * Hangprinter inverse kinematics along the segments of a straight move
+     *
+     * Squared line lengths grow by q = s(k) - s(k-1) per segment, and q grows
+     * by the constant 2*|d|^2 for segment vector d. Each new length is then
+     * L + dl, where dl = q / (2*L + dl). The divisor uses the previous dl, and
+     * its reciprocal is refined from the previous one by a Newton step, so a
+     * segment needs neither square roots nor divisions.
+     *
+     * The error is below 1.5 * l^3 / L^2 per segment of length l, L being the
+     * shortest line length along the move. Every HANGPRINTER_IK_EXACT_EVERY
+     * segments the lengths are calculated exactly, so neither this error nor
+     * float rounding of the sums can build up over a long move.
+     */
+    #define HANGPRINTER_IK_EXACT_EVERY 8
+
+    static float ik_q[ABCD], ik_dl[ABCD], ik_recip[ABCD], ik_dq;
+    static uint8_t ik_exact_countdown;
+
+    #if ENABLED(HANGPRINTER_IK_CHECK)
+      // Largest difference from the exact lengths in the current move, and in all moves
+      static float ik_check_move_error, ik_check_error;
+      static uint32_t ik_check_segments;
+
+      // With M111 S2 report the differences of the move just done
+      void hangprinter_ik_check_report() {
+        NOLESS(ik_check_error, ik_check_move_error);
+        if (DEBUGGING(INFO)) {
+          SERIAL_ECHO_START();
+          SERIAL_ECHOPAIR("IK check: move error ", ik_check_move_error * 1000);
+          SERIAL_ECHOPAIR("um, largest ", ik_check_error * 1000);
+          SERIAL_ECHOPAIR("um in ", ik_check_segments);
+          SERIAL_ECHOLNPGM(" segments");
+        }
+        ik_check_move_error = 0;
+      }
+    #endif
+
+    /**
+     * Set up for the segments of the move starting at raw.
+     * Return false if the error could exceed HANGPRINTER_IK_TOLERANCE.
+     */
+    inline bool hangprinter_ik_start(const float (&raw)[XYZE], const float (&segment_distance)[XYZE], const uint16_t segments) {
+      const float anchor[ABCD][XYZ] = {
+                    { 0, anchor_A_y, anchor_A_z },
+                    { anchor_B_x, anchor_B_y, anchor_B_z },
+                    { anchor_C_x, anchor_C_y, anchor_C_z },
+                    { 0, 0, anchor_D_z }
+                  },
+                  a = sq(segment_distance[X_AXIS]) + sq(segment_distance[Y_AXIS]) + sq(segment_distance[Z_AXIS]),
+                  max_error = 1.5f * MIN(segments, HANGPRINTER_IK_EXACT_EVERY) * a * SQRT(a);
+
+      LOOP_MOV_AXIS(i) {
+        const float dx = raw[X_AXIS] - anchor[i][X_AXIS],
+                    dy = raw[Y_AXIS] - anchor[i][Y_AXIS],
+                    dz = raw[Z_AXIS] - anchor[i][Z_AXIS],
+                    s = sq(dx) + sq(dy) + sq(dz),
+                    b = 2 * (dx * segment_distance[X_AXIS] + dy * segment_distance[Y_AXIS] + dz * segment_distance[Z_AXIS]),
+                    t = -b / (2 * a),                             // Segments to the point closest to the anchor
+                    s_min = t <= 0 ? s
+                          : t >= segments ? s + (b + a * segments) * segments
+                          : s + 0.5f * b * t;
+        if (max_error > (HANGPRINTER_IK_TOLERANCE) * s_min) return false;
+
+        line_lengths[i] = SQRT(s);
+        ik_q[i] = b + a;
+        ik_dl[i] = ik_q[i] / (2 * line_lengths[i]);
+        ik_recip[i] = 1.0f / (2 * line_lengths[i] + ik_dl[i]);
+      }
+      ik_dq = 2 * a;
+      ik_exact_countdown = HANGPRINTER_IK_EXACT_EVERY;
+      return true;
+    }
+
+    // Advance line_lengths[ABCD] to the next segment, ending at raw
+    FORCE_INLINE void hangprinter_ik_next(const float (&raw)[XYZE]) {
+      LOOP_MOV_AXIS(i) {
+        const float divisor = 2 * line_lengths[i] + ik_dl[i];
+        ik_recip[i] *= 2 - divisor * ik_recip[i];
+        ik_dl[i] = ik_q[i] * ik_recip[i];
+        line_lengths[i] += ik_dl[i];
+        ik_q[i] += ik_dq;
+      }
+      #if ENABLED(HANGPRINTER_IK_CHECK)
+        float incremental[ABCD];
+        COPY(incremental, line_lengths);
+        HANGPRINTER_IK(raw);
+        LOOP_MOV_AXIS(i) NOLESS(ik_check_move_error, ABS(incremental[i] - line_lengths[i]));
+        COPY(line_lengths, incremental);
+        ik_check_segments++;
+      #endif
+      if (!--ik_exact_countdown) {
+        ik_exact_countdown = HANGPRINTER_IK_EXACT_EVERY;
+        HANGPRINTER_IK(raw);
+      }
+    }
+
+  #endif // HANGPRINTER_INCREMENTAL_IK
+
   /**
    * Hangprinter forward kinematics
    * Basic idea is to subtract squared line lengths to get linear equations.
@@ -14065,6 +14445,61 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
     #define SCARA_MIN_SEGMENT_LENGTH 0.5f
   #endif
 
+  #if ENABLED(ADAPTIVE_KINEMATIC_SEGMENTS)
+
+    /**
+     * Segments needed to keep a straight move from 'start' by 'diff' within
+     * KINEMATIC_SEGMENT_ERROR of the true joint positions.
+     *
+     * Interpolating a joint position q linearly over h mm of the move misses
+     * by at most h^2 * |q''| / 8, so only the largest |q''| along the move
+     * (per mm^2 of travel) decides the segment length.
+     */
+    float kinematic_segments(const float (&start)[XYZE], const float (&diff)[XYZ]) {
+      const float mm = SQRT(sq(diff[X_AXIS]) + sq(diff[Y_AXIS]) + sq(diff[Z_AXIS]));
+      if (UNEAR_ZERO(mm)) return 1;
+      const float inv_mm = 1.0f / mm;
+      float curvature = 0;
+
+      #if ENABLED(HANGPRINTER)
+        // A line of length l has l'' = d^2 / l^3, where d is the distance from its anchor
+        // to the path of the move. It is largest where the move passes closest to the anchor.
+        const float anchor[ABCD][XYZ] = {
+                      { 0, anchor_A_y, anchor_A_z },
+                      { anchor_B_x, anchor_B_y, anchor_B_z },
+                      { anchor_C_x, anchor_C_y, anchor_C_z },
+                      { 0, 0, anchor_D_z }
+                    };
+        LOOP_MOV_AXIS(i) {
+          const float dx = start[X_AXIS] - anchor[i][X_AXIS],
+                      dy = start[Y_AXIS] - anchor[i][Y_AXIS],
+                      dz = start[Z_AXIS] - anchor[i][Z_AXIS],
+                      s = sq(dx) + sq(dy) + sq(dz),
+                      proj = (dx * diff[X_AXIS] + dy * diff[Y_AXIS] + dz * diff[Z_AXIS]) * inv_mm,
+                      t = constrain(-proj, 0, mm),      // mm to the point closest to the anchor
+                      l2 = s + (2 * proj + t) * t;
+          NOLESS(curvature, (s - sq(proj)) / (l2 * SQRT(l2)));
+        }
+      #else
+        // A carriage at height h = sqrt(R^2 - r^2) over the effector has |h''| <= R^2 / h^3
+        // per unit of horizontal travel. It is largest where the move is farthest from the
+        // tower, which is at one of its ends.
+        const float horizontal_sqr = (sq(diff[X_AXIS]) + sq(diff[Y_AXIS])) * sq(inv_mm);
+        LOOP_XYZ(i) {
+          const float h2 = delta_diagonal_rod_2_tower[i] - MAX(
+                        HYPOT2(start[X_AXIS] - delta_tower[i][X_AXIS], start[Y_AXIS] - delta_tower[i][Y_AXIS]),
+                        HYPOT2(start[X_AXIS] + diff[X_AXIS] - delta_tower[i][X_AXIS], start[Y_AXIS] + diff[Y_AXIS] - delta_tower[i][Y_AXIS])
+                      );
+          if (h2 <= 0) return 65535; // Out of reach. Segments per second will limit it.
+          NOLESS(curvature, horizontal_sqr * delta_diagonal_rod_2_tower[i] / (h2 * SQRT(h2)));
+        }
+      #endif
+
+      return CEIL(mm * SQRT(curvature * (1.0f / (8 * (KINEMATIC_SEGMENT_ERROR)))));
+    }
+
+  #endif // ADAPTIVE_KINEMATIC_SEGMENTS
+
   /**
    * Prepare a linear move in a DELTA, SCARA or HANGPRINTER setup.
    *
@@ -14120,6 +14555,12 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
     // gives the number of segments
     uint16_t segments = delta_segments_per_second * seconds;
 
+    #if ENABLED(ADAPTIVE_KINEMATIC_SEGMENTS)
+      // Segments per second is now the upper limit. Use fewer where the kinematics are nearly linear.
+      const float diff[XYZ] = { xdiff, ydiff, zdiff };
+      NOMORE(segments, kinematic_segments(current_position, diff));
+    #endif
+
     // For SCARA enforce a minimum segment size
     #if IS_SCARA
       NOMORE(segments, cartesian_mm * (1.0f / float(SCARA_MIN_SEGMENT_LENGTH)));
@@ -14185,6 +14626,10 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
     float raw[XYZE];
     COPY(raw, current_position);
 
+    #if ENABLED(HANGPRINTER_INCREMENTAL_IK)
+      const bool incremental_ik = hangprinter_ik_start(raw, segment_distance, segments);
+    #endif
+
     // Calculate and execute the segments
     while (--segments) {
 
@@ -14196,10 +14641,19 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
       }
 
       LOOP_XYZE(i) raw[i] += segment_distance[i];
+      #if ENABLED(CARTESIAN_JUNCTIONS)
+        planner.set_cartesian_direction(raw);
+      #endif
       #if ENABLED(DELTA) && HOTENDS < 2
         DELTA_IK(raw); // Delta can inline its kinematics
       #elif ENABLED(HANGPRINTER)
-        HANGPRINTER_IK(raw); // Modifies line_lengths[ABCD]
+        #if ENABLED(HANGPRINTER_INCREMENTAL_IK)
+          if (incremental_ik) {
+            hangprinter_ik_next(raw); // Modifies line_lengths[ABCD]
+          }
+          else
+        #endif
+            HANGPRINTER_IK(raw); // Modifies line_lengths[ABCD]
       #else
         inverse_kinematics(raw);
       #endif
@@ -14241,6 +14695,10 @@ void set_current_from_steppers_for_axis(const AxisEnum axis) {
       #endif
     }
 
+    #if ENABLED(HANGPRINTER_IK_CHECK)
+      if (incremental_ik) hangprinter_ik_check_report();
+    #endif
+
     // Ensure last segment arrives at target location.
     #if HAS_FEEDRATE_SCALING
       inverse_kinematics(rtarget);
@@ -14463,6 +14921,10 @@ void prepare_move_to_destination() {
    * Arcs should only be made relatively large (over 5mm), as larger arcs with
    * larger segments will tend to be more efficient. Your slicer should have
    * options for G2/G3 arc generation. In future these options may be GCode tunable.
+   *
+   * With ARC_CURVE_PLANNING the segments are the longest chords that stay within
+   * ARC_CHORD_ERROR of the arc, and the planner joins them at the speed allowed by
+   * the arc radius rather than by the angle between chords.
    */
   void plan_arc(
     const float (&cart)[XYZE], // Destination position
@@ -14505,8 +14967,21 @@ void prepare_move_to_destination() {
                 mm_of_travel = linear_travel ? HYPOT(flat_mm, linear_travel) : ABS(flat_mm);
     if (mm_of_travel < 0.001f) return;
 
-    uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
-    NOLESS(segments, 1);
+    #if ENABLED(ARC_CURVE_PLANNING)
+      // Chord whose sagitta is ARC_CHORD_ERROR: c = 2 * sqrt(e * (2r - e))
+      const float chord_mm = radius > (ARC_CHORD_ERROR)
+        ? constrain(2 * SQRT((ARC_CHORD_ERROR) * (2 * radius - (ARC_CHORD_ERROR))), MIN_ARC_SEGMENT_MM, MAX_ARC_SEGMENT_MM)
+        : MIN_ARC_SEGMENT_MM;
+      uint16_t segments = CEIL(MAX(ABS(flat_mm) / chord_mm, mm_of_travel / (MAX_ARC_SEGMENT_MM)));
+      NOLESS(segments, 1);
+      const float mm_per_segment = mm_of_travel / segments;
+    #else
+      uint16_t segments = FLOOR(mm_of_travel / (MM_PER_ARC_SEGMENT));
+      NOLESS(segments, 1);
+      #if HAS_FEEDRATE_SCALING || HAS_UBL_AND_CURVES
+        constexpr float mm_per_segment = MM_PER_ARC_SEGMENT;
+      #endif
+    #endif
 
     /**
      * Vector rotation by transformation matrix: r is the original vector, r_T is the rotated vector,
@@ -14539,8 +15014,13 @@ void prepare_move_to_destination() {
     const float theta_per_segment = angular_travel / segments,
                 linear_per_segment = linear_travel / segments,
                 extruder_per_segment = extruder_travel / segments,
-                sin_T = theta_per_segment,
-                cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+                #if ENABLED(ARC_CURVE_PLANNING)
+                  sin_T = sin(theta_per_segment),             // Chords may span too wide an angle
+                  cos_T = cos(theta_per_segment);             // for the small angle approximation
+                #else
+                  sin_T = theta_per_segment,
+                  cos_T = 1 - 0.5f * sq(theta_per_segment); // Small angle approximation
+                #endif
 
     // Initialize the linear axis
     raw[l_axis] = current_position[l_axis];
@@ -14554,7 +15034,7 @@ void prepare_move_to_destination() {
 
     #if HAS_FEEDRATE_SCALING
       // SCARA needs to scale the feed rate from mm/s to degrees/s
-      const float inv_segment_length = 1.0f / (MM_PER_ARC_SEGMENT),
+      const float inv_segment_length = 1.0f / mm_per_segment,
                   inverse_secs = inv_segment_length * fr_mm_s;
       float oldA = planner.position_float[A_AXIS],
             oldB = planner.position_float[B_AXIS]
@@ -14615,23 +15095,30 @@ void prepare_move_to_destination() {
       #if ENABLED(SCARA_FEEDRATE_SCALING)
         // For SCARA scale the feed rate from mm/s to degrees/s
         // i.e., Complete the angular vector in the given time.
-        if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_CART], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder, MM_PER_ARC_SEGMENT))
+        if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], raw[Z_AXIS], raw[E_CART], HYPOT(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB) * inverse_secs, active_extruder, mm_per_segment))
           break;
         oldA = delta[A_AXIS]; oldB = delta[B_AXIS];
       #elif ENABLED(DELTA_FEEDRATE_SCALING)
         // For DELTA scale the feed rate from Effector mm/s to Carriage mm/s
         // i.e., Complete the linear vector in the given time.
-        if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], SQRT(sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC)) * inverse_secs, active_extruder, MM_PER_ARC_SEGMENT))
+        if (!planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], raw[E_AXIS], SQRT(sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC)) * inverse_secs, active_extruder, mm_per_segment))
           break;
         oldA = delta[A_AXIS]; oldB = delta[B_AXIS]; oldC = delta[C_AXIS];
       #elif HAS_UBL_AND_CURVES
         float pos[XYZ] = { raw[X_AXIS], raw[Y_AXIS], raw[Z_AXIS] };
         planner.apply_leveling(pos);
-        if (!planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], raw[E_CART], fr_mm_s, active_extruder, MM_PER_ARC_SEGMENT))
+        if (!planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], raw[E_CART], fr_mm_s, active_extruder, mm_per_segment))
           break;
       #else
-        if (!planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder))
-          break;
+        if (!planner.buffer_line_kinematic(raw, fr_mm_s, active_extruder
+          #if ENABLED(ARC_CURVE_PLANNING)
+            , mm_per_segment
+          #endif
+        )) break;
+      #endif
+
+      #if ENABLED(ARC_CURVE_PLANNING) && !HAS_FEEDRATE_SCALING
+        planner.arc_radius = radius; // Following chords meet on the arc
       #endif
     }
 
@@ -14644,17 +15131,25 @@ void prepare_move_to_destination() {
     #if ENABLED(SCARA_FEEDRATE_SCALING)
       const float diff2 = HYPOT2(delta[A_AXIS] - oldA, delta[B_AXIS] - oldB);
       if (diff2)
-        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], cart[Z_AXIS], cart[E_CART], SQRT(diff2) * inverse_secs, active_extruder, MM_PER_ARC_SEGMENT);
+        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], cart[Z_AXIS], cart[E_CART], SQRT(diff2) * inverse_secs, active_extruder, mm_per_segment);
     #elif ENABLED(DELTA_FEEDRATE_SCALING)
       const float diff2 = sq(delta[A_AXIS] - oldA) + sq(delta[B_AXIS] - oldB) + sq(delta[C_AXIS] - oldC);
       if (diff2)
-        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], cart[E_CART], SQRT(diff2) * inverse_secs, active_extruder, MM_PER_ARC_SEGMENT);
+        planner.buffer_segment(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], cart[E_CART], SQRT(diff2) * inverse_secs, active_extruder, mm_per_segment);
     #elif HAS_UBL_AND_CURVES
       float pos[XYZ] = { cart[X_AXIS], cart[Y_AXIS], cart[Z_AXIS] };
       planner.apply_leveling(pos);
-      planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], cart[E_CART], fr_mm_s, active_extruder, MM_PER_ARC_SEGMENT);
+      planner.buffer_segment(pos[X_AXIS], pos[Y_AXIS], pos[Z_AXIS], cart[E_CART], fr_mm_s, active_extruder, mm_per_segment);
     #else
-      planner.buffer_line_kinematic(cart, fr_mm_s, active_extruder);
+      planner.buffer_line_kinematic(cart, fr_mm_s, active_extruder
+        #if ENABLED(ARC_CURVE_PLANNING)
+          , mm_per_segment
+        #endif
+      );
+    #endif
+
+    #if ENABLED(ARC_CURVE_PLANNING)
+      planner.arc_radius = 0;
     #endif
 
     COPY(current_position, cart);
@@ -14897,7 +15392,7 @@ void manage_inactivity(const bool ignore_stepper_queue/*=false*/) {
     runout.run();
   #endif
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (queue_has_room()) get_available_commands();
 
   const millis_t ms = millis();
 
@@ -15093,6 +15588,10 @@ void idle(
     bool no_stepper_sleep/*=false*/
   #endif
 ) {
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_IDLE);
+  #endif
+
   #if ENABLED(MAX7219_DEBUG)
     max7219.idle_tasks();
   #endif
@@ -15125,6 +15624,10 @@ void idle(
     }
   #endif
 
+  #if ENABLED(MECHADUINO_TELEMETRY)
+    mechaduino_telemetry.update();
+  #endif
+
   #if HAS_AUTO_REPORTING
     if (!suspend_auto_report) {
       #if ENABLED(AUTO_REPORT_TEMPERATURES)
@@ -15133,6 +15636,9 @@ void idle(
       #if ENABLED(AUTO_REPORT_SD_STATUS)
         card.auto_report_sd_status();
       #endif
+      #if ENABLED(PROFILE_HOT_PATHS)
+        profiler.auto_report();
+      #endif
     }
   #endif
 }
@@ -15279,7 +15785,7 @@ void setup() {
   SERIAL_ECHOLNPAIR(MSG_PLANNER_BUFFER_BYTES, int(sizeof(block_t))*(BLOCK_BUFFER_SIZE));
 
   // Send "ok" after commands by default
-  for (int8_t i = 0; i < BUFSIZE; i++) send_ok[i] = true;
+  for (uint8_t i = 0; i < COMMAND_SLOTS; i++) send_ok[i] = true;
 
   // Load data from EEPROM if available (or use defaults)
   // This also updates variables in the planner, elsewhere
@@ -15299,6 +15805,10 @@ void setup() {
 
   print_job_timer.init();   // Initial setup of print job timer
 
+  #if ENABLED(PROFILE_HOT_PATHS)
+    profiler.reset();       // Start the first profile window
+  #endif
+
   endstops.init();          // Init endstops and pullups
 
   stepper.init();           // Init stepper. This enables interrupts!
@@ -15502,14 +16012,22 @@ void loop() {
 
   #endif // SDSUPPORT
 
-  if (commands_in_queue < BUFSIZE) get_available_commands();
+  if (queue_has_room()) get_available_commands();
 
   if (commands_in_queue) {
 
     #if ENABLED(SDSUPPORT)
 
       if (card.saving) {
-        char* command = command_queue[cmd_queue_index_r];
+        char* command = QUEUED_COMMAND(cmd_queue_index_r);
+        #if ENABLED(PARSED_COMMAND_QUEUE)
+          // Lines queued behind M28 may be packed already
+          char text[MAX_CMD_SIZE];
+          if (*command == PACKED_COMMAND_MARK) {
+            parser.unpack(text, command, sizeof(text));
+            command = text;
+          }
+        #endif
         if (strstr_P(command, PSTR("M29"))) {
           // M29 closes the file
           card.closefile();
@@ -15551,7 +16069,7 @@ void loop() {
     // The queue may be reset by a command handler or by code invoked by idle() within a handler
     if (commands_in_queue) {
       --commands_in_queue;
-      if (++cmd_queue_index_r >= BUFSIZE) cmd_queue_index_r = 0;
+      if (++cmd_queue_index_r >= COMMAND_SLOTS) cmd_queue_index_r = 0;
     }
   }
   endstops.event_handler();
@@ -421,6 +421,13 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #error "Graphical LCD is required for SHOW_CUSTOM_BOOTSCREEN and CUSTOM_STATUS_SCREEN_IMAGE."
 #endif
 
+/**
+ * Info Screen drawing only what has changed
+ */
+#if ENABLED(DOGM_STATUS_DIRTY_PAGES) && ENABLED(LIGHTWEIGHT_UI)
+  #error "DOGM_STATUS_DIRTY_PAGES does not apply to LIGHTWEIGHT_UI."
+#endif
+
 /**
  * SD File Sorting
  */
@@ -749,8 +756,24 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
       #error "ANCHOR_D_Z should be positive by convention."
     #endif
   #endif
+  #if ENABLED(HANGPRINTER_INCREMENTAL_IK)
+    static_assert(HANGPRINTER_IK_TOLERANCE > 0, "HANGPRINTER_IK_TOLERANCE must be greater than 0.");
+  #endif
+  #if ENABLED(LINE_BUILDUP_TABLE)
+    #if DISABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
+      #error "LINE_BUILDUP_TABLE requires LINE_BUILDUP_COMPENSATION_FEATURE."
+    #elif !WITHIN(LINE_BUILDUP_TABLE_SIZE, 2, 255)
+      #error "LINE_BUILDUP_TABLE_SIZE must be from 2 to 255."
+    #endif
+  #endif
 #elif ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
   #error "LINE_BUILDUP_COMPENSATION_FEATURE is only compatible with HANGPRINTER."
+#elif ENABLED(HANGPRINTER_INCREMENTAL_IK)
+  #error "HANGPRINTER_INCREMENTAL_IK is only compatible with HANGPRINTER."
+#endif
+
+#if ENABLED(HANGPRINTER_IK_CHECK) && DISABLED(HANGPRINTER_INCREMENTAL_IK)
+  #error "HANGPRINTER_IK_CHECK requires HANGPRINTER_INCREMENTAL_IK."
 #endif
 
 /**
@@ -1365,6 +1388,109 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #error "EMERGENCY_PARSER does not work on boards with AT90USB processors (USBCON)."
 #endif
 
+/**
+ * Binary G-code protocol
+ */
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  #if DISABLED(FASTER_GCODE_PARSER)
+    #error "BINARY_GCODE_PROTOCOL requires FASTER_GCODE_PARSER."
+  #elif DISABLED(EXTENDED_CAPABILITIES_REPORT)
+    #error "BINARY_GCODE_PROTOCOL requires EXTENDED_CAPABILITIES_REPORT, so hosts can detect it."
+  #elif ENABLED(EMERGENCY_PARSER)
+    #error "BINARY_GCODE_PROTOCOL is not compatible with EMERGENCY_PARSER, which could act on bytes of binary frames."
+  #elif MAX_CMD_SIZE < 54
+    #error "BINARY_GCODE_PROTOCOL requires MAX_CMD_SIZE of at least 54."
+  #endif
+#endif
+
+/**
+ * Parsed command queue
+ */
+#if ENABLED(PARSED_COMMAND_QUEUE) && DISABLED(FASTER_GCODE_PARSER)
+  #error "PARSED_COMMAND_QUEUE requires FASTER_GCODE_PARSER."
+#endif
+
+/**
+ * Command arena
+ */
+#if ENABLED(COMMAND_ARENA)
+  #if !WITHIN(COMMAND_ARENA_SLOTS, 2, 255)
+    #error "COMMAND_ARENA_SLOTS must be from 2 to 255."
+  #elif BUFSIZE < 2
+    #error "COMMAND_ARENA requires BUFSIZE of at least 2."
+  #elif BUFSIZE * MAX_CMD_SIZE > 65535
+    #error "COMMAND_ARENA requires BUFSIZE * MAX_CMD_SIZE of at most 65535."
+  #endif
+#endif
+
+/**
+ * Arc curve planning
+ */
+#if ENABLED(ARC_CURVE_PLANNING)
+  #if DISABLED(ARC_SUPPORT)
+    #error "ARC_CURVE_PLANNING requires ARC_SUPPORT."
+  #elif !defined(ARC_CHORD_ERROR) || !defined(MIN_ARC_SEGMENT_MM) || !defined(MAX_ARC_SEGMENT_MM)
+    #error "ARC_CURVE_PLANNING requires ARC_CHORD_ERROR, MIN_ARC_SEGMENT_MM, and MAX_ARC_SEGMENT_MM."
+  #endif
+  static_assert(ARC_CHORD_ERROR > 0, "ARC_CHORD_ERROR must be greater than 0.");
+  static_assert(MIN_ARC_SEGMENT_MM > 0 && MIN_ARC_SEGMENT_MM <= MAX_ARC_SEGMENT_MM, "MIN_ARC_SEGMENT_MM must be greater than 0 and no more than MAX_ARC_SEGMENT_MM.");
+#endif
+
+/**
+ * Step rate tables
+ */
+#if ENABLED(STEP_RATE_TABLE)
+  #if ENABLED(S_CURVE_ACCELERATION)
+    #error "STEP_RATE_TABLE is not compatible with S_CURVE_ACCELERATION."
+  #elif ENABLED(ADAPTIVE_STEP_SMOOTHING)
+    #error "STEP_RATE_TABLE is not compatible with ADAPTIVE_STEP_SMOOTHING."
+  #elif !WITHIN(STEP_RATE_TABLE_SEGMENTS, 1, 32)
+    #error "STEP_RATE_TABLE_SEGMENTS must be from 1 to 32."
+  #endif
+#endif
+
+/**
+ * Coalesced port writes
+ */
+#if ENABLED(COALESCE_PORT_WRITES)
+  #if ENABLED(X_DUAL_STEPPER_DRIVERS) || ENABLED(Y_DUAL_STEPPER_DRIVERS) || ENABLED(Z_DUAL_STEPPER_DRIVERS)
+    #error "COALESCE_PORT_WRITES is not compatible with dual stepper drivers."
+  #elif ENABLED(DUAL_X_CARRIAGE)
+    #error "COALESCE_PORT_WRITES is not compatible with DUAL_X_CARRIAGE."
+  #elif HAS_DRIVER(L6470)
+    #error "COALESCE_PORT_WRITES is not compatible with L6470 drivers."
+  #elif !HAS_X_STEP || !HAS_Y_STEP || !HAS_Z_STEP || !HAS_X_DIR || !HAS_Y_DIR || !HAS_Z_DIR
+    #error "COALESCE_PORT_WRITES requires X, Y, and Z step and direction pins."
+  #endif
+#endif
+
+/**
+ * Adaptive kinematic segments
+ */
+#if ENABLED(ADAPTIVE_KINEMATIC_SEGMENTS)
+  #if DISABLED(DELTA) && DISABLED(HANGPRINTER)
+    #error "ADAPTIVE_KINEMATIC_SEGMENTS requires DELTA or HANGPRINTER."
+  #elif ENABLED(AUTO_BED_LEVELING_UBL)
+    #error "ADAPTIVE_KINEMATIC_SEGMENTS is not compatible with AUTO_BED_LEVELING_UBL."
+  #elif ENABLED(DELTA) && ENABLED(AUTO_BED_LEVELING_BILINEAR)
+    #error "ADAPTIVE_KINEMATIC_SEGMENTS would skip over the AUTO_BED_LEVELING_BILINEAR grid on DELTA."
+  #elif !defined(KINEMATIC_SEGMENT_ERROR)
+    #error "ADAPTIVE_KINEMATIC_SEGMENTS requires KINEMATIC_SEGMENT_ERROR."
+  #endif
+  static_assert(KINEMATIC_SEGMENT_ERROR > 0, "KINEMATIC_SEGMENT_ERROR must be greater than 0.");
+#endif
+
+/**
+ * Cartesian junctions
+ */
+#if ENABLED(CARTESIAN_JUNCTIONS)
+  #if !IS_KINEMATIC
+    #error "CARTESIAN_JUNCTIONS requires DELTA, SCARA, or HANGPRINTER."
+  #elif DISABLED(JUNCTION_DEVIATION)
+    #error "CARTESIAN_JUNCTIONS requires JUNCTION_DEVIATION. Classic jerk limits joint speeds."
+  #endif
+#endif
+
 /**
  * I2C bus
  */
@@ -1376,6 +1502,46 @@ static_assert(X_MAX_LENGTH >= X_BED_SIZE && Y_MAX_LENGTH >= Y_BED_SIZE,
   #endif
 #endif
 
+#if ENABLED(TWIBUS_ASYNC)
+  #if DISABLED(EXPERIMENTAL_I2CBUS)
+    #error "TWIBUS_ASYNC requires EXPERIMENTAL_I2CBUS."
+  #elif I2C_SLAVE_ADDRESS > 0
+    #error "TWIBUS_ASYNC only works as an I2C master. Set I2C_SLAVE_ADDRESS to 0."
+  #elif ENABLED(LCD_I2C_TYPE_PCF8575) || ENABLED(LCD_I2C_TYPE_PCA8574) || ENABLED(LCD_I2C_TYPE_MCP23017) || ENABLED(LCD_I2C_TYPE_MCP23008)
+    #error "TWIBUS_ASYNC replaces the Wire library, which I2C LCDs require."
+  #elif ENABLED(DIGIPOT_I2C) || ENABLED(DAC_STEPPER_CURRENT) || ENABLED(BLINKM) || ENABLED(PCA9632)
+    #error "TWIBUS_ASYNC replaces the Wire library, which DIGIPOT_I2C, DAC_STEPPER_CURRENT, BLINKM and PCA9632 require."
+  #elif !WITHIN(TWIBUS_QUEUE_SIZE, 2, 255)
+    #error "TWIBUS_QUEUE_SIZE must be between 2 and 255."
+  #endif
+#endif
+
+/**
+ * EEPROM journal
+ */
+#if ENABLED(EEPROM_JOURNAL)
+  #if DISABLED(EEPROM_SETTINGS)
+    #error "EEPROM_JOURNAL requires EEPROM_SETTINGS."
+  #elif EEPROM_JOURNAL_SIZE < 64
+    #error "EEPROM_JOURNAL_SIZE must be at least 64."
+  #endif
+#endif
+
+/**
+ * Mechaduino line length telemetry
+ */
+#if ENABLED(MECHADUINO_TELEMETRY)
+  #if DISABLED(HANGPRINTER) || DISABLED(MECHADUINO_I2C_COMMANDS)
+    #error "MECHADUINO_TELEMETRY requires HANGPRINTER and MECHADUINO_I2C_COMMANDS."
+  #elif DISABLED(TWIBUS_ASYNC)
+    #error "MECHADUINO_TELEMETRY requires TWIBUS_ASYNC."
+  #elif DISABLED(A_IS_MECHADUINO) && DISABLED(B_IS_MECHADUINO) && DISABLED(C_IS_MECHADUINO) && DISABLED(D_IS_MECHADUINO)
+    #error "MECHADUINO_TELEMETRY requires at least one of A_IS_MECHADUINO, B_IS_MECHADUINO, C_IS_MECHADUINO or D_IS_MECHADUINO."
+  #elif !WITHIN(MECHADUINO_TELEMETRY_BUFFER, 2, 255)
+    #error "MECHADUINO_TELEMETRY_BUFFER must be between 2 and 255."
+  #endif
+#endif
+
 /**
  * G38 Probe Target
  */
@@ -1676,6 +1842,28 @@ static_assert(COUNT(sanity_arr_3) <= NUM_AXIS_N, "DEFAULT_MAX_ACCELERATION has t
 
 #if !BLOCK_BUFFER_SIZE || !IS_POWER_OF_2(BLOCK_BUFFER_SIZE)
   #error "BLOCK_BUFFER_SIZE must be a power of 2."
+#elif BLOCK_BUFFER_SIZE > 256
+  #error "BLOCK_BUFFER_SIZE must be 256 or less."
+#endif
+
+/**
+ * Deep lookahead
+ */
+#if ENABLED(DEEP_LOOKAHEAD)
+  #ifdef __AVR__
+    #error "DEEP_LOOKAHEAD needs more RAM than AVR boards have."
+  #elif BLOCK_BUFFER_SIZE < 64
+    #error "DEEP_LOOKAHEAD requires a BLOCK_BUFFER_SIZE of 64 or more."
+  #elif !defined(LOOKAHEAD_REPLAN_MAX) || !WITHIN(LOOKAHEAD_REPLAN_MAX, 2, 255)
+    #error "DEEP_LOOKAHEAD requires LOOKAHEAD_REPLAN_MAX between 2 and 255."
+  #endif
+#endif
+
+/**
+ * Merging collinear blocks
+ */
+#if ENABLED(MERGE_COLLINEAR_BLOCKS) && !defined(MERGE_BLOCKS_TOLERANCE)
+  #error "MERGE_COLLINEAR_BLOCKS requires MERGE_BLOCKS_TOLERANCE."
 #endif
 
 #if ENABLED(LED_CONTROL_MENU) && DISABLED(ULTIPANEL)
@@ -165,6 +165,11 @@
 
 // send command and return error code.  Return zero for OK
 uint8_t Sd2Card::cardCommand(uint8_t cmd, uint32_t arg) {
+  #if ENABLED(SD_READ_AHEAD)
+    // end a multiple block read before any other command
+    if (streamBlock_ != STREAM_NONE && cmd != CMD12) readStop();
+  #endif
+
   // select card
   chipSelectLow();
 
@@ -299,6 +304,9 @@ bool Sd2Card::eraseSingleBlockEnable() {
  */
 bool Sd2Card::init(uint8_t sckRateID, pin_t chipSelectPin) {
   errorCode_ = type_ = 0;
+  #if ENABLED(SD_READ_AHEAD)
+    streamBlock_ = STREAM_NONE;
+  #endif
   chipSelectPin_ = chipSelectPin;
   // 16-bit init start time allows over a minute
   uint16_t t0 = (uint16_t)millis();
@@ -543,6 +551,9 @@ bool Sd2Card::readRegister(uint8_t cmd, void* buf) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readStart(uint32_t blockNumber) {
+  #if ENABLED(SD_READ_AHEAD)
+    const uint32_t firstBlock = blockNumber;
+  #endif
   if (type() != SD_CARD_TYPE_SDHC) blockNumber <<= 9;
   if (cardCommand(CMD18, blockNumber)) {
     error(SD_CARD_ERROR_CMD18);
@@ -550,6 +561,9 @@ bool Sd2Card::readStart(uint32_t blockNumber) {
     return false;
   }
   chipSelectHigh();
+  #if ENABLED(SD_READ_AHEAD)
+    streamBlock_ = firstBlock;
+  #endif
   return true;
 }
 
@@ -559,6 +573,9 @@ bool Sd2Card::readStart(uint32_t blockNumber) {
  * \return true for success, false for failure.
  */
 bool Sd2Card::readStop() {
+  #if ENABLED(SD_READ_AHEAD)
+    streamBlock_ = STREAM_NONE;
+  #endif
   chipSelectLow();
   if (cardCommand(CMD12, 0)) {
     error(SD_CARD_ERROR_CMD12);
@@ -569,6 +586,30 @@ bool Sd2Card::readStop() {
   return true;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Read a 512 byte block with a multiple block read sequence. Blocks read
+   * in order follow on with no command, and any other command ends the
+   * sequence. On an error the block is read again with readBlock().
+   *
+   * \param[in] blockNumber Logical block to be read.
+   * \param[out] dst Pointer to the location that will receive the data.
+   * \return true for success, false for failure.
+   */
+  bool Sd2Card::streamBlock(uint32_t blockNumber, uint8_t* dst) {
+    if (blockNumber != streamBlock_ && !readStart(blockNumber))
+      return readBlock(blockNumber, dst);
+    if (!readData(dst)) {
+      readStop();
+      return readBlock(blockNumber, dst);
+    }
+    streamBlock_ = blockNumber + 1;
+    return true;
+  }
+
+#endif // SD_READ_AHEAD
+
 /**
  * Set the SPI clock rate.
  *
@@ -113,7 +113,11 @@ uint8_t const SD_CARD_TYPE_SD1  = 1,                    // Standard capacity V1
 class Sd2Card {
   public:
 
-  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0) {}
+  Sd2Card() : errorCode_(SD_CARD_ERROR_INIT_NOT_CALLED), type_(0)
+    #if ENABLED(SD_READ_AHEAD)
+      , streamBlock_(STREAM_NONE)
+    #endif
+  {}
 
   uint32_t cardSize();
   bool erase(uint32_t firstBlock, uint32_t lastBlock);
@@ -167,6 +171,10 @@ class Sd2Card {
   bool readData(uint8_t* dst);
   bool readStart(uint32_t blockNumber);
   bool readStop();
+  #if ENABLED(SD_READ_AHEAD)
+    bool streamBlock(uint32_t blockNumber, uint8_t* dst);
+    void streamStop() { if (streamBlock_ != STREAM_NONE) readStop(); }
+  #endif
   bool setSckRate(uint8_t sckRateID);
   /**
    * Return the card type: SD V1, SD V2 or SDHC
@@ -185,6 +193,11 @@ class Sd2Card {
           status_,
           type_;
 
+  #if ENABLED(SD_READ_AHEAD)
+    static uint32_t const STREAM_NONE = 0xFFFFFFFF;
+    uint32_t streamBlock_;  // Next block of the multiple block read sequence, if one is open
+  #endif
+
   // private functions
   uint8_t cardAcmd(uint8_t cmd, uint32_t arg) {
     cardCommand(CMD55, 0);
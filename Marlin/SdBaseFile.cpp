@@ -1038,6 +1038,84 @@ int16_t SdBaseFile::read(void* buf, uint16_t nbyte) {
   return nbyte;
 }
 
+/**
+ * Read data from a file without copying it. The data from the current
+ * position to the end of its block is read into the volume cache, or
+ * into the read-ahead buffers with SD_READ_AHEAD.
+ *
+ * \param[out] data Pointer to the data in the cache. It's only valid
+ * until the next use of the volume cache, or of readAhead().
+ *
+ * \return The number of bytes read, which is zero at end of file.
+ * If an error occurs, readCached() returns -1.
+ */
+int16_t SdBaseFile::readCached(const uint8_t* &data) {
+  uint32_t block,            // raw device block number
+           cluster = curCluster_;
+  #if ENABLED(SD_READ_AHEAD)
+    bool nextInCluster = false;
+  #endif
+
+  // error if not open or write only
+  if (!isOpen() || !(flags_ & O_READ)) return -1;
+
+  // nothing left at end of file
+  if (curPosition_ >= fileSize_) return 0;
+
+  const uint16_t offset = curPosition_ & 0x1FF;  // offset in block
+  if (type_ == FAT_FILE_TYPE_ROOT_FIXED) {
+    block = vol_->rootDirStart() + (curPosition_ >> 9);
+  }
+  else {
+    uint8_t blockOfCluster = vol_->blockOfCluster(curPosition_);
+    if (offset == 0 && blockOfCluster == 0) {
+      // start of new cluster
+      if (curPosition_ == 0)
+        cluster = firstCluster_;                  // use first cluster in file
+      else if (!vol_->fatGet(cluster, &cluster))  // get next cluster from FAT
+        return -1;
+    }
+    block = vol_->clusterStartBlock(cluster) + blockOfCluster;
+    #if ENABLED(SD_READ_AHEAD)
+      nextInCluster = blockOfCluster + 1 < vol_->blocksPerCluster_;
+    #endif
+  }
+
+  // amount to the end of the block or file
+  uint16_t n = 512 - offset;
+  NOMORE(n, fileSize_ - curPosition_);
+
+  // on failure the position is unchanged, so it can be read again
+  #if ENABLED(SD_READ_AHEAD)
+    uint8_t* src = vol_->readAheadBlock(block, nextInCluster && curPosition_ + n < fileSize_);
+    if (!src) return -1;
+    data = src + offset;
+  #else
+    if (!vol_->cacheRawBlock(block, SdVolume::CACHE_FOR_READ)) return -1;
+    data = vol_->cache()->data + offset;
+  #endif
+  curCluster_ = cluster;
+  curPosition_ += n;
+  return n;
+}
+
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Start reading this file ahead for readCached(). A contiguous file is
+   * read ahead through its whole length, any other file within each cluster.
+   */
+  void SdBaseFile::readAheadStart() {
+    uint32_t bgnBlock, endBlock;
+    if (fileSize_ && contiguousRange(&bgnBlock, &endBlock))
+      endBlock = bgnBlock + ((fileSize_ - 1) >> 9);  // The last block with file data
+    else
+      bgnBlock = endBlock = 0;
+    vol_->readAheadStart(bgnBlock, endBlock);
+  }
+
+#endif // SD_READ_AHEAD
+
 /**
  * Read the next entry in a directory.
  *
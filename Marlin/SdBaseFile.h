@@ -302,6 +302,11 @@ class SdBaseFile {
   bool printName();
   int16_t read();
   int16_t read(void* buf, uint16_t nbyte);
+  int16_t readCached(const uint8_t* &data);
+  #if ENABLED(SD_READ_AHEAD)
+    void readAheadStart();
+    bool readAhead() { return vol_->readAhead(); }
+  #endif
   int8_t readDir(dir_t* dir, char* longFilename);
   static bool remove(SdBaseFile* dirFile, const char* path);
   bool remove();
@@ -39,6 +39,14 @@
   Sd2Card* SdVolume::sdCard_;            // pointer to SD card object
   bool     SdVolume::cacheDirty_;        // cacheFlush() will write block if true
   uint32_t SdVolume::cacheMirrorBlock_;  // mirror  block for second FAT
+  #if ENABLED(SD_READ_AHEAD)
+    cache_t  SdVolume::aheadBuffer_[2];    // 512 byte buffers for the file being read ahead
+    uint32_t SdVolume::aheadBlock_[2],     // block number in each buffer
+             SdVolume::aheadNext_,         // next block to read ahead
+             SdVolume::aheadBgnBlock_,     // blocks of a contiguous file
+             SdVolume::aheadEndBlock_;
+    uint8_t  SdVolume::aheadIndex_;        // buffer of the block being read
+  #endif
 #endif  // USE_MULTIPLE_CARDS
 
 // find a contiguous group of clusters
@@ -139,6 +147,70 @@ bool SdVolume::cacheRawBlock(uint32_t blockNumber, bool dirty) {
   return true;
 }
 
+#if ENABLED(SD_READ_AHEAD)
+
+  /**
+   * Start reading a file ahead. Clear the buffers and stop any read.
+   *
+   * \param[in] bgnBlock The first block of a contiguous file, or 0.
+   * \param[in] endBlock The last block of a contiguous file, or 0.
+   */
+  void SdVolume::readAheadStart(const uint32_t bgnBlock, const uint32_t endBlock) {
+    readAheadStop();
+    aheadBgnBlock_ = bgnBlock;
+    aheadEndBlock_ = endBlock;
+  }
+
+  /**
+   * Stop reading ahead and clear the buffers
+   */
+  void SdVolume::readAheadStop() {
+    aheadBlock_[0] = aheadBlock_[1] = aheadNext_ = 0xFFFFFFFF;
+    aheadBgnBlock_ = aheadEndBlock_ = 0;
+    if (sdCard_) sdCard_->streamStop();
+  }
+
+  /**
+   * Get a block of the file being read ahead, reading it if it wasn't read
+   * ahead already. The following block is read ahead by readAhead() if it's
+   * in the same cluster or in a contiguous file.
+   *
+   * \param[in] blockNumber Logical block to be read.
+   * \param[in] nextInCluster The next block of the file is in the same cluster.
+   * \return A pointer to the data or zero if an error occurs.
+   */
+  uint8_t* SdVolume::readAheadBlock(const uint32_t blockNumber, const bool nextInCluster) {
+    if (aheadBlock_[aheadIndex_] != blockNumber) {
+      aheadIndex_ ^= 1;
+      if (aheadBlock_[aheadIndex_] != blockNumber) {
+        aheadBlock_[aheadIndex_] = 0xFFFFFFFF;
+        if (!sdCard_->streamBlock(blockNumber, aheadBuffer_[aheadIndex_].data)) return 0;
+        aheadBlock_[aheadIndex_] = blockNumber;
+      }
+    }
+    aheadNext_ = nextInCluster || (blockNumber >= aheadBgnBlock_ && blockNumber < aheadEndBlock_)
+      ? blockNumber + 1 : 0xFFFFFFFF;
+    return aheadBuffer_[aheadIndex_].data;
+  }
+
+  /**
+   * Read the next block of the file into the other buffer, if it's known
+   * and not read yet. Call when there's time to spare.
+   *
+   * \return true for success, false for failure.
+   */
+  bool SdVolume::readAhead() {
+    const uint8_t i = aheadIndex_ ^ 1;
+    if (aheadNext_ == 0xFFFFFFFF || aheadBlock_[i] == aheadNext_) return true;
+    aheadBlock_[i] = 0xFFFFFFFF;
+    const bool ok = sdCard_->streamBlock(aheadNext_, aheadBuffer_[i].data);
+    if (ok) aheadBlock_[i] = aheadNext_;
+    aheadNext_ = 0xFFFFFFFF;
+    return ok;
+  }
+
+#endif // SD_READ_AHEAD
+
 // return the size in bytes of a cluster chain
 bool SdVolume::chainSize(uint32_t cluster, uint32_t* size) {
   uint32_t s = 0;
@@ -315,6 +387,9 @@ bool SdVolume::init(Sd2Card* dev, uint8_t part) {
   cacheDirty_ = 0;  // cacheFlush() will write block if true
   cacheMirrorBlock_ = 0;
   cacheBlockNumber_ = 0xFFFFFFFF;
+  #if ENABLED(SD_READ_AHEAD)
+    readAheadStop();
+  #endif
 
   // if part == 0 assume super floppy with FAT boot sector in block zero
   // if part > 0 assume mbr volume with partition table
@@ -110,6 +110,12 @@ class SdVolume {
    */
   Sd2Card* sdCard() { return sdCard_; }
 
+  #if ENABLED(SD_READ_AHEAD)
+    void readAheadStart(const uint32_t bgnBlock, const uint32_t endBlock);
+    bool readAhead();
+    void readAheadStop();
+  #endif
+
   /**
    * Debug access to FAT table
    *
@@ -134,12 +140,28 @@ class SdVolume {
     Sd2Card* sdCard_;            // Sd2Card object for cache
     bool cacheDirty_;            // cacheFlush() will write block if true
     uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    #if ENABLED(SD_READ_AHEAD)
+      cache_t aheadBuffer_[2];     // 512 byte buffers for the file being read ahead
+      uint32_t aheadBlock_[2],     // Logical number of the block in each buffer
+               aheadNext_,         // Next block to read ahead
+               aheadBgnBlock_,     // Blocks of a contiguous file
+               aheadEndBlock_;
+      uint8_t aheadIndex_;         // Buffer of the block being read
+    #endif
   #else
     static cache_t cacheBuffer_;        // 512 byte cache for device blocks
     static uint32_t cacheBlockNumber_;  // Logical number of block in the cache
     static Sd2Card* sdCard_;            // Sd2Card object for cache
     static bool cacheDirty_;            // cacheFlush() will write block if true
     static uint32_t cacheMirrorBlock_;  // block number for mirror FAT
+    #if ENABLED(SD_READ_AHEAD)
+      static cache_t aheadBuffer_[2];     // 512 byte buffers for the file being read ahead
+      static uint32_t aheadBlock_[2],     // Logical number of the block in each buffer
+                      aheadNext_,         // Next block to read ahead
+                      aheadBgnBlock_,     // Blocks of a contiguous file
+                      aheadEndBlock_;
+      static uint8_t aheadIndex_;         // Buffer of the block being read
+    #endif
   #endif
 
   uint32_t allocSearchStart_;   // start cluster for alloc search
@@ -162,6 +184,10 @@ class SdVolume {
   cache_t* cache() { return &cacheBuffer_; }
   uint32_t cacheBlockNumber() const { return cacheBlockNumber_; }
 
+  #if ENABLED(SD_READ_AHEAD)
+    uint8_t* readAheadBlock(const uint32_t blockNumber, const bool nextInCluster);
+  #endif
+
   #if USE_MULTIPLE_CARDS
     bool cacheFlush();
     bool cacheRawBlock(uint32_t blockNumber, bool dirty);
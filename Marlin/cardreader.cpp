@@ -31,6 +31,10 @@
 #include "language.h"
 #include "printcounter.h"
 
+#if ENABLED(SD_PRINT_INDEX)
+  #include "duration_t.h"
+#endif
+
 #if ENABLED(POWER_LOSS_RECOVERY)
   #include "power_loss_recovery.h"
 #endif
@@ -45,6 +49,12 @@ CardReader::CardReader() {
     #endif
   #endif
   sdprinting = cardOK = saving = logging = false;
+  #if ENABLED(SD_PRINT_INDEX)
+    index_building = index_valid = false;
+  #endif
+  #if ENABLED(SD_DIR_CACHE)
+    dircache_checked = dircache_valid = false;
+  #endif
   filesize = 0;
   sdpos = 0;
   file_subcall_ctr = 0;
@@ -72,6 +82,18 @@ char *createFilename(char *buffer, const dir_t &p) { //buffer > 12characters
   return buffer;
 }
 
+/**
+ * Is a directory entry shown in listings? Skip deleted, hidden and dot
+ * files, and files with no G-code extension.
+ */
+static bool is_listed(const dir_t &p, const char * const longFilename) {
+  const uint8_t pn0 = p.name[0];
+  if (pn0 == DIR_NAME_DELETED || pn0 == '.') return false;
+  if (longFilename[0] == '.') return false;
+  if (!DIR_IS_FILE_OR_SUBDIR(&p) || (p.attributes & DIR_ATT_HIDDEN)) return false;
+  return DIR_IS_SUBDIR(&p) || (p.name[8] == 'G' && p.name[9] != '~');
+}
+
 /**
  * Dive into a folder and recurse depth-first to perform a pre-set operation lsAction:
  *   LS_Count       - Add +1 to nrFiles for every file within the parent
@@ -123,17 +145,11 @@ void CardReader::lsDive(const char *prepend, SdFile parent, const char * const m
       // close() is done automatically by destructor of SdFile
     }
     else {
-      uint8_t pn0 = p.name[0];
-      if (pn0 == DIR_NAME_FREE) break;
-      if (pn0 == DIR_NAME_DELETED || pn0 == '.') continue;
-      if (longFilename[0] == '.') continue;
-
-      if (!DIR_IS_FILE_OR_SUBDIR(&p) || (p.attributes & DIR_ATT_HIDDEN)) continue;
+      if (p.name[0] == DIR_NAME_FREE) break;
+      if (!is_listed(p, longFilename)) continue;
 
       filenameIsDir = DIR_IS_SUBDIR(&p);
 
-      if (!filenameIsDir && (p.name[8] != 'G' || p.name[9] == '~')) continue;
-
       switch (lsAction) {  // 1 based file count
         case LS_Count:
           nrFiles++;
@@ -316,7 +332,15 @@ void CardReader::stopSDPrint(
     did_pause_print = 0;
   #endif
   sdprinting = abort_sd_printing = false;
-  if (isFileOpen()) file.close();
+  #if ENABLED(SD_PRINT_INDEX)
+    index_close();
+  #endif
+  if (isFileOpen()) {
+    file.close();
+    #if ENABLED(SD_READ_AHEAD)
+      volume.readAheadStop();
+    #endif
+  }
   #if SD_RESORT
     if (re_sort) presort();
   #endif
@@ -401,6 +425,12 @@ void CardReader::openFile(char * const path, const bool read, const bool subcall
     if (file.open(curDir, fname, O_READ)) {
       filesize = file.fileSize();
       sdpos = 0;
+      #if ENABLED(SD_READ_AHEAD)
+        file.readAheadStart();
+      #endif
+      #if ENABLED(SD_PRINT_INDEX)
+        if (!file_subcall_ctr) index_open();
+      #endif
       SERIAL_PROTOCOLPAIR(MSG_SD_FILE_OPENED, fname);
       SERIAL_PROTOCOLLNPAIR(MSG_SD_SIZE, filesize);
       SERIAL_PROTOCOLLNPGM(MSG_SD_FILE_SELECTED);
@@ -425,6 +455,9 @@ void CardReader::openFile(char * const path, const bool read, const bool subcall
     }
     else {
       saving = true;
+      #if ENABLED(SD_DIR_CACHE)
+        dircache_flush();
+      #endif
       SERIAL_PROTOCOLLNPAIR(MSG_SD_WRITE_TO_FILE, path);
       lcd_setstatus(fname);
     }
@@ -444,6 +477,9 @@ void CardReader::removeFile(const char * const name) {
     SERIAL_PROTOCOLPGM("File deleted:");
     SERIAL_PROTOCOLLN(fname);
     sdpos = 0;
+    #if ENABLED(SD_DIR_CACHE)
+      dircache_flush();
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -461,11 +497,62 @@ void CardReader::getStatus() {
     SERIAL_PROTOCOL(sdpos);
     SERIAL_PROTOCOLCHAR('/');
     SERIAL_PROTOCOLLN(filesize);
+    #if ENABLED(SD_PRINT_INDEX)
+      if (index_valid) {
+        char buffer[21];
+        duration_t(index_time_left()).toString(buffer);
+        SERIAL_ECHO_START();
+        SERIAL_ECHOPAIR("Layer ", index_layer);
+        SERIAL_ECHOPAIR("/", index_head.layers);
+        SERIAL_ECHOLNPAIR(" Time left: ", buffer);
+      }
+    #endif
   }
   else
     SERIAL_PROTOCOLLNPGM(MSG_SD_NOT_PRINTING);
 }
 
+/**
+ * Read the next line of the file into 'buf', without comments and without
+ * characters beyond 'size' - 1. The file data is scanned in place, a block
+ * at a time, and the file position is only updated at the end of the line.
+ *
+ * The line ends at '\n', '\r', end of file, or '#' or ':' outside of a
+ * comment. 'term' is set to the character that ended it, or 0 at the end
+ * of the file. Return the length of the line, or -1 on a read error.
+ */
+int16_t CardReader::get_line(char * const buf, const uint8_t size, char &term) {
+  uint8_t count = 0;
+  bool comment = false;
+  term = '\0';
+  for (;;) {
+    const uint8_t *data;
+    const int16_t n = file.readCached(data);
+    if (n < 0) { file.seekSet(sdpos); return -1; } // Read the whole line again next time
+    if (n == 0) { sdpos = filesize; break; }
+
+    int16_t i = 0;
+    for (; i < n; i++) {
+      const char c = data[i];
+      if (c == '\n' || c == '\r') break;
+      if (comment) continue;
+      if (c == '#' || c == ':') break;
+      if (c == ';') comment = true;
+      else if (count < size - 1) buf[count++] = c;
+    }
+
+    if (i < n) {
+      // Give back the data after the end of the line
+      term = data[i];
+      sdpos = file.curPosition() - (n - i - 1);
+      if (sdpos < file.curPosition()) file.seekSet(sdpos);
+      break;
+    }
+  }
+  buf[count] = '\0';
+  return count;
+}
+
 void CardReader::write_command(char *buf) {
   char* begin = buf;
   char* npos = NULL;
@@ -528,6 +615,9 @@ void CardReader::beginautostart() {
 void CardReader::closefile(const bool store_location) {
   file.sync();
   file.close();
+  #if ENABLED(SD_DIR_CACHE)
+    if (saving) dircache_flush();
+  #endif
   saving = logging = false;
 
   if (store_location) {
@@ -555,6 +645,21 @@ void CardReader::getfilename(uint16_t nr, const char * const match/*=NULL*/) {
       return;
     }
   #endif // SDSORT_CACHE_NAMES
+  #if ENABLED(SD_DIR_CACHE)
+    if (dircache_ready()) {
+      sd_dircache_entry_t entry;
+      for (; dircache_read(nr, entry); nr++) {
+        if (match != NULL && strcasecmp(match, entry.name) != 0) continue;
+        strcpy(filename, entry.name);
+        filenameIsDir = entry.isDir;
+        dir_t p;
+        if (entry.lfn_index == entry.index // No long name entries
+          || !workDir.seekSet(32UL * entry.lfn_index) || workDir.readDir(&p, longFilename) <= 0
+        ) longFilename[0] = '\0';
+        return;
+      }
+    }
+  #endif
   lsAction = LS_GetFilename;
   nrFile_index = nr;
   workDir.rewind();
@@ -562,6 +667,9 @@ void CardReader::getfilename(uint16_t nr, const char * const match/*=NULL*/) {
 }
 
 uint16_t CardReader::getnrfilenames() {
+  #if ENABLED(SD_DIR_CACHE)
+    if (dircache_ready()) return dircache_head.count;
+  #endif
   lsAction = LS_Count;
   nrFiles = 0;
   workDir.rewind();
@@ -611,6 +719,9 @@ void CardReader::chdir(const char * relpath) {
     workDir = newDir;
     if (workDirDepth < MAX_DIR_DEPTH)
       workDirParents[workDirDepth++] = workDir;
+    #if ENABLED(SD_DIR_CACHE)
+      dircache_flush();
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -625,6 +736,9 @@ void CardReader::chdir(const char * relpath) {
 int8_t CardReader::updir() {
   if (workDirDepth > 0) {                                               // At least 1 dir has been saved
     workDir = --workDirDepth ? workDirParents[workDirDepth - 1] : root; // Use parent, or root if none
+    #if ENABLED(SD_DIR_CACHE)
+      dircache_flush();
+    #endif
     #if ENABLED(SDCARD_SORT_ALPHA)
       presort();
     #endif
@@ -637,6 +751,9 @@ void CardReader::setroot() {
     SERIAL_ECHOLNPGM(MSG_SD_WORKDIR_FAIL);
   }*/
   workDir = root;
+  #if ENABLED(SD_DIR_CACHE)
+    dircache_flush();
+  #endif
   #if ENABLED(SDCARD_SORT_ALPHA)
     presort();
   #endif
@@ -889,6 +1006,9 @@ uint16_t CardReader::get_num_Files() {
 void CardReader::printingHasFinished() {
   planner.synchronize();
   file.close();
+  #if ENABLED(SD_READ_AHEAD)
+    volume.readAheadStop();
+  #endif
   if (file_subcall_ctr > 0) { // Heading up to a parent file that called current as a procedure.
     file_subcall_ctr--;
     openFile(proc_filenames[file_subcall_ctr], true, true);
@@ -898,6 +1018,10 @@ void CardReader::printingHasFinished() {
   else {
     sdprinting = false;
 
+    #if ENABLED(SD_PRINT_INDEX)
+      index_finish();
+    #endif
+
     #if ENABLED(POWER_LOSS_RECOVERY)
       removeJobRecoveryFile();
     #endif
@@ -933,6 +1057,306 @@ void CardReader::printingHasFinished() {
   }
 #endif // AUTO_REPORT_SD_STATUS
 
+#if ENABLED(SD_PRINT_INDEX)
+
+  #define SD_INDEX_MIN_LAYER 0.05 // (mm) Smallest Z step taken as a new layer, e.g., in spiral vase mode
+
+  // The index is named by the first cluster of the print file, e.g., "00001A2B.IDX"
+  static void index_file_name(char * const name, const uint32_t cluster) {
+    sprintf_P(name, PSTR("%08lX.IDX"), (unsigned long)cluster);
+  }
+
+  /**
+   * Open the index of the print file. An index that's complete and matches
+   * the file is used, otherwise a new one is built as the file prints.
+   */
+  void CardReader::index_open() {
+    index_close();
+    dir_t entry;
+    if (!file.dirEntry(&entry)) return;
+
+    char name[13];
+    index_file_name(name, file.firstCluster());
+    if (indexFile.open(&root, name, O_READ)) {
+      index_valid = indexFile.read(&index_head, sizeof(index_head)) == sizeof(index_head)
+        && index_head.filesize == filesize
+        && index_head.date == entry.lastWriteDate && index_head.time == entry.lastWriteTime
+        && index_head.print_time && index_head.layers;
+      if (index_valid) {
+        index_load(0);
+        index_t0 = index_d0 = 0;
+        return;
+      }
+      indexFile.close();
+    }
+
+    // The index file is only created at the first layer
+    index_head.filesize = filesize;
+    index_head.date = entry.lastWriteDate;
+    index_head.time = entry.lastWriteTime;
+    index_head.print_time = 0;
+    index_head.layers = 0;
+    index_z = index_layer_z = 0;
+    index_z_pos = 0;
+    index_building = true;
+  }
+
+  void CardReader::index_close() {
+    if (indexFile.isOpen()) indexFile.close();
+    index_building = index_valid = false;
+  }
+
+  /**
+   * Complete the index that was built while the file printed
+   */
+  void CardReader::index_finish() {
+    if (index_building && indexFile.isOpen()) {
+      index_head.print_time = MAX(print_job_timer.duration(), 1UL);
+      indexFile.seekSet(0);
+      indexFile.write(&index_head, sizeof(index_head));
+    }
+    index_close();
+  }
+
+  /**
+   * Called with each command read from the print file and its position.
+   * While building, add a layer at the first extrusion above the last layer,
+   * starting from the Z move before it. Absolute Z moves are expected.
+   * With a complete index, follow the layers as the file is read.
+   */
+  void CardReader::index_command(const char * const cmd, const uint32_t pos) {
+    if (index_valid) {
+      while (index_layer < index_head.layers && pos >= index_next.sdpos) index_load(index_layer + 1);
+      return;
+    }
+    if (!index_building || cmd[0] != 'G' || (cmd[1] != '0' && cmd[1] != '1') || NUMERIC(cmd[2])) return;
+
+    const char * const z = strchr(cmd, 'Z');
+    if (z) {
+      index_z = strtod(z + 1, NULL);
+      index_z_pos = pos;
+    }
+    if (index_z < index_layer_z + SD_INDEX_MIN_LAYER || !strchr(cmd, 'E') || !(strchr(cmd, 'X') || strchr(cmd, 'Y')))
+      return;
+    index_layer_z = index_z;
+
+    if (!indexFile.isOpen()) {
+      char name[13];
+      index_file_name(name, file.firstCluster());
+      if (!indexFile.open(&root, name, O_CREAT | O_WRITE | O_TRUNC)
+          || indexFile.write(&index_head, sizeof(index_head)) != sizeof(index_head)
+      ) {
+        index_close();
+        return;
+      }
+    }
+
+    const sd_index_layer_t layer = { index_z_pos, index_z, (uint32_t)print_job_timer.duration() };
+    if (indexFile.write(&layer, sizeof(layer)) == sizeof(layer))
+      index_head.layers++;
+    else
+      index_close();
+  }
+
+  bool CardReader::index_read(const uint16_t layer, sd_index_layer_t &entry) {
+    return indexFile.seekSet(sizeof(index_head) + (uint32_t)layer * sizeof(entry))
+        && indexFile.read(&entry, sizeof(entry)) == sizeof(entry);
+  }
+
+  /**
+   * Load the layers before and after the start of the given layer.
+   * The print starts and ends with a layer of its own.
+   */
+  void CardReader::index_load(const uint16_t layer) {
+    index_layer = layer;
+    if (!layer)
+    {
+      index_cur.sdpos = index_cur.print_time = 0;
+      index_cur.z = 0;
+    }
+    else if (!index_read(layer - 1, index_cur))
+      index_valid = false;
+
+    if (layer >= index_head.layers) {
+      index_next.sdpos = filesize;
+      index_next.z = index_cur.z;
+      index_next.print_time = index_head.print_time;
+    }
+    else if (!index_read(layer, index_next))
+      index_valid = false;
+  }
+
+  /**
+   * Follow a change of the file position. An index that's being
+   * built is dropped, a complete one finds the layer by bisection.
+   */
+  void CardReader::index_seek() {
+    if (index_building)
+      index_close();
+    else if (index_valid) {
+      uint16_t lo = 0, hi = index_head.layers;
+      while (lo < hi) {
+        const uint16_t mid = (lo + hi) >> 1;
+        sd_index_layer_t entry;
+        if (!index_read(mid, entry)) { index_valid = false; return; }
+        if (entry.sdpos <= sdpos) lo = mid + 1; else hi = mid;
+      }
+      index_load(lo);
+      // The job timer only covers the part printed since here.
+      // It restarts from zero unless the job is only paused.
+      index_t0 = index_time();
+      index_d0 = (print_job_timer.isRunning() || print_job_timer.isPaused()) ? print_job_timer.duration() : 0;
+    }
+  }
+
+  /**
+   * Seek to the start of a layer (1...) of a file with a complete index
+   */
+  bool CardReader::seek_layer(const uint16_t layer) {
+    sd_index_layer_t entry;
+    if (!index_valid || !WITHIN(layer, 1, index_head.layers) || !index_read(layer - 1, entry)) return false;
+    setIndex(entry.sdpos);
+    SERIAL_ECHO_START();
+    SERIAL_ECHOPAIR("Layer ", layer);
+    SERIAL_ECHOPAIR(" Z", entry.z);
+    SERIAL_ECHOLNPAIR(" at byte ", entry.sdpos);
+    return true;
+  }
+
+  // Print time of the indexed print at the current position
+  uint32_t CardReader::index_time() {
+    const uint32_t span = index_next.sdpos - index_cur.sdpos;
+    if (!span || sdpos <= index_cur.sdpos) return index_cur.print_time;
+    if (sdpos >= index_next.sdpos) return index_next.print_time;
+    return index_cur.print_time + (float)(sdpos - index_cur.sdpos) / span * (index_next.print_time - index_cur.print_time);
+  }
+
+  uint8_t CardReader::index_percent() {
+    return MIN(index_time() * 100 / index_head.print_time, 100UL);
+  }
+
+  /**
+   * Seconds left by the index, scaled by the pace of this print
+   */
+  uint32_t CardReader::index_time_left() {
+    if (!index_valid) return 0;
+    const uint32_t t = index_time();
+    if (t >= index_head.print_time) return 0;
+    const uint32_t left = index_head.print_time - t,
+                   d = print_job_timer.duration();
+    // Scale by the actual/estimated ratio since the print started or resumed
+    if (t < index_t0 + 60 || d <= index_d0) return left;
+    return left * ((float)(d - index_d0) / (t - index_t0));
+  }
+
+#endif // SD_PRINT_INDEX
+
+#if ENABLED(SD_DIR_CACHE)
+
+  #define SD_DIR_CACHE_WRITE 4 // Entries written to the list at once
+
+  static uint32_t dircache_hash(uint32_t hash, const void * const data, const uint8_t size) {
+    const uint8_t *b = (const uint8_t*)data;
+    for (uint8_t i = size; i--;) hash = ((hash << 5) + hash) ^ *b++;
+    return hash;
+  }
+
+  /**
+   * Close the list of the working directory. It's checked again when next used.
+   * Call when the working directory changes, or a file in it is added or removed.
+   */
+  void CardReader::dircache_flush() {
+    if (dircacheFile.isOpen()) dircacheFile.close();
+    dircache_checked = dircache_valid = false;
+  }
+
+  /**
+   * Count and hash the listed items of the working directory into the given
+   * head, writing an entry for each item to the list file, if given.
+   */
+  bool CardReader::dircache_scan(sd_dircache_head_t &head, SdFile * const out/*=NULL*/) {
+    memset(&head, 0, sizeof(head));
+    head.cluster = workDir.firstCluster();
+    head.dirsize = workDir.fileSize();
+    head.hash = 5381;
+
+    // Entries are written in groups to save block writes while the directory is read
+    dir_t p;
+    sd_dircache_entry_t entry[SD_DIR_CACHE_WRITE];
+    uint8_t e = 0;
+    int8_t n;
+    workDir.rewind();
+    for (;;) {
+      const uint16_t lfn_index = workDir.curPosition() >> 5;
+      if ((n = workDir.readDir(&p, longFilename)) <= 0) break;
+      if (!is_listed(p, longFilename)) continue;
+
+      sd_dircache_entry_t &en = entry[e];
+      memset(&en, 0, sizeof(en));
+      createFilename(en.name, p);
+      en.isDir = DIR_IS_SUBDIR(&p);
+      en.index = (workDir.curPosition() >> 5) - 1;
+      en.lfn_index = lfn_index;
+      en.date = p.lastWriteDate;
+      en.time = p.lastWriteTime;
+      en.size = p.fileSize;
+      head.hash = dircache_hash(head.hash, &en, sizeof(en));
+      head.hash = dircache_hash(head.hash, longFilename, strlen(longFilename));
+      head.count++;
+
+      if (++e == COUNT(entry)) {
+        if (out && out->write(entry, sizeof(entry)) != sizeof(entry)) return false;
+        e = 0;
+      }
+    }
+    if (out && e) {
+      const uint16_t size = e * sizeof(entry[0]);
+      if (out->write(entry, size) != size) return false;
+    }
+    return n == 0;
+  }
+
+  /**
+   * Open the list of the working directory. A list that matches the items
+   * of the directory is used, otherwise it's rebuilt.
+   */
+  void CardReader::dircache_open() {
+    dircache_flush();
+    dircache_checked = true;
+    if (!dircache_scan(dircache_head)) return;
+
+    // The list is named by the first cluster of the folder, e.g., "00000000.LST" for a FAT16 root
+    char name[13];
+    sprintf_P(name, PSTR("%08lX.LST"), (unsigned long)dircache_head.cluster);
+
+    sd_dircache_head_t head;
+    if (dircacheFile.open(&root, name, O_READ)) {
+      dircache_valid = dircacheFile.read(&head, sizeof(head)) == sizeof(head)
+        && !memcmp(&head, &dircache_head, sizeof(head));
+      if (dircache_valid) return;
+      dircacheFile.close();
+    }
+
+    // The head is written with no size until the list is complete
+    if (!dircacheFile.open(&root, name, O_CREAT | O_RDWR | O_TRUNC)) return;
+    head = dircache_head;
+    head.dirsize = 0;
+    dircache_valid = dircacheFile.write(&head, sizeof(head)) == sizeof(head)
+      && dircache_scan(dircache_head, &dircacheFile)
+      && dircacheFile.seekSet(0)
+      && dircacheFile.write(&dircache_head, sizeof(dircache_head)) == sizeof(dircache_head)
+      && dircacheFile.sync();
+    if (!dircache_valid) dircacheFile.close();
+  }
+
+  bool CardReader::dircache_read(const uint16_t nr, sd_dircache_entry_t &entry) {
+    return nr < dircache_head.count
+        && dircacheFile.seekSet(sizeof(dircache_head) + (uint32_t)nr * sizeof(entry))
+        && dircacheFile.read(&entry, sizeof(entry)) == sizeof(entry);
+  }
+
+#endif // SD_DIR_CACHE
+
 #if ENABLED(POWER_LOSS_RECOVERY)
 
   char job_recovery_file_name[4] = "bin";
@@ -33,6 +33,40 @@
 
 #include "SdFile.h"
 
+#if ENABLED(SD_PRINT_INDEX)
+  // Head of a print file index, followed by an sd_index_layer_t per layer
+  typedef struct {
+    uint32_t filesize;              // Size of the indexed file
+    uint16_t date, time;            // Last write of the indexed file
+    uint32_t print_time;            // Seconds for the whole print. 0 until the print completes.
+    uint16_t layers;
+  } sd_index_head_t;
+
+  typedef struct {
+    uint32_t sdpos;                 // Position of the Z move that starts the layer
+    float z;
+    uint32_t print_time;            // Seconds from the start of the print
+  } sd_index_layer_t;
+#endif
+
+#if ENABLED(SD_DIR_CACHE)
+  // Head of a folder list, followed by an sd_dircache_entry_t per listed item
+  typedef struct {
+    uint32_t cluster, dirsize;      // First cluster and chain size of the folder
+    uint32_t hash;                  // Hash of the listed items, in order
+    uint16_t count;
+  } sd_dircache_head_t;
+
+  typedef struct {
+    char name[FILENAME_LENGTH];     // DOS 8.3 name
+    bool isDir;
+    uint16_t index,                 // Directory entry of the item
+             lfn_index;             // First directory entry to read for the long name
+    uint16_t date, time;            // Last write
+    uint32_t size;
+  } sd_dircache_entry_t;
+#endif
+
 class CardReader {
 public:
   CardReader();
@@ -100,11 +134,31 @@ public:
   FORCE_INLINE bool isFileOpen() { return file.isOpen(); }
   FORCE_INLINE bool eof() { return sdpos >= filesize; }
   FORCE_INLINE int16_t get() { sdpos = file.curPosition(); return (int16_t)file.read(); }
-  FORCE_INLINE void setIndex(const uint32_t index) { sdpos = index; file.seekSet(index); }
+  int16_t get_line(char * const buf, const uint8_t size, char &term);
+  #if ENABLED(SD_READ_AHEAD)
+    FORCE_INLINE void readAhead() { file.readAhead(); }
+  #endif
+  FORCE_INLINE void setIndex(const uint32_t index) {
+    sdpos = index; file.seekSet(index);
+    #if ENABLED(SD_PRINT_INDEX)
+      index_seek();
+    #endif
+  }
   FORCE_INLINE uint32_t getIndex() { return sdpos; }
-  FORCE_INLINE uint8_t percentDone() { return (isFileOpen() && filesize) ? sdpos / ((filesize + 99) / 100) : 0; }
+  FORCE_INLINE uint8_t percentDone() {
+    #if ENABLED(SD_PRINT_INDEX)
+      if (index_valid) return index_percent();
+    #endif
+    return (isFileOpen() && filesize) ? sdpos / ((filesize + 99) / 100) : 0;
+  }
   FORCE_INLINE char* getWorkDirName() { workDir.getFilename(filename); return filename; }
 
+  #if ENABLED(SD_PRINT_INDEX)
+    void index_command(const char * const cmd, const uint32_t pos);
+    bool seek_layer(const uint16_t layer);
+    uint32_t index_time_left();
+  #endif
+
   #if ENABLED(AUTO_REPORT_SD_STATUS)
     void auto_report_sd_status(void);
     FORCE_INLINE void set_auto_report_interval(uint8_t v) {
@@ -182,6 +236,45 @@ private:
     SdFile jobRecoveryFile;
   #endif
 
+  #if ENABLED(SD_PRINT_INDEX)
+    SdFile indexFile;
+    sd_index_head_t index_head;
+    bool index_building,            // Adding layers while the file prints for the first time
+         index_valid;               // The file has a complete index
+    // Building
+    float index_z, index_layer_z;   // Z of the last Z move and of the last layer
+    uint32_t index_z_pos;           // Position of the last Z move
+    // Using
+    uint16_t index_layer;           // Next layer, between index_cur and index_next
+    sd_index_layer_t index_cur, index_next;
+    uint32_t index_t0, index_d0;    // Print time and job timer where printing started or resumed
+
+    void index_open();
+    void index_close();
+    void index_finish();
+    bool index_read(const uint16_t layer, sd_index_layer_t &entry);
+    void index_load(const uint16_t layer);
+    void index_seek();
+    uint32_t index_time();
+    uint8_t index_percent();
+  #endif
+
+  #if ENABLED(SD_DIR_CACHE)
+    SdFile dircacheFile;
+    sd_dircache_head_t dircache_head;
+    bool dircache_checked,          // The list of the working directory was checked
+         dircache_valid;            // ...and is open and up to date
+
+    void dircache_flush();
+    void dircache_open();
+    bool dircache_scan(sd_dircache_head_t &head, SdFile * const out=NULL);
+    bool dircache_read(const uint16_t nr, sd_dircache_entry_t &entry);
+    FORCE_INLINE bool dircache_ready() {
+      if (!dircache_checked) dircache_open();
+      return dircache_valid;
+    }
+  #endif
+
   #define SD_PROCEDURE_DEPTH 1
   #define MAXPATHNAMELENGTH (FILENAME_LENGTH*MAX_DIR_DEPTH + MAX_DIR_DEPTH + 1)
   uint8_t file_subcall_ctr;
@@ -386,6 +386,15 @@ void MarlinSettings::postprocess() {
 
   void MarlinSettings::write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc) {
     if (eeprom_error) { pos += size; return; }
+    #if ENABLED(EEPROM_JOURNAL)
+      // Changes to the settings go to the journal
+      if (!journal_direct && uint16_t(pos - (EEPROM_OFFSET)) < datasize()) {
+        journal_write(pos - (EEPROM_OFFSET), value, size);
+        crc16(crc, value, size);
+        pos += size;
+        return;
+      }
+    #endif
     while (size--) {
       uint8_t * const p = (uint8_t * const)pos;
       uint8_t v = *value;
@@ -408,6 +417,22 @@ void MarlinSettings::postprocess() {
 
   void MarlinSettings::read_data(int &pos, uint8_t* value, uint16_t size, uint16_t *crc, const bool force/*=false*/) {
     if (eeprom_error) { pos += size; return; }
+    #if ENABLED(EEPROM_JOURNAL)
+      // The settings are read with the journal applied
+      if (!journal_direct && uint16_t(pos - (EEPROM_OFFSET)) < datasize()) {
+        uint8_t buf[16];
+        while (size) {
+          const uint8_t n = size < sizeof(buf) ? size : sizeof(buf);
+          journal_read(pos - (EEPROM_OFFSET), buf, n);
+          if (!validating || force) memcpy(value, buf, n);
+          crc16(crc, buf, n);
+          pos += n;
+          value += n;
+          size -= n;
+        }
+        return;
+      }
+    #endif
     do {
       uint8_t c = eeprom_read_byte((unsigned char*)pos);
       if (!validating || force) *value = c;
@@ -426,10 +451,270 @@ void MarlinSettings::postprocess() {
     return false;
   }
 
+  #if ENABLED(EEPROM_JOURNAL)
+
+    /**
+     * EEPROM journal
+     *
+     * The settings image is only written in place now and then. In between,
+     * each save appends records of the bytes that changed to a journal after it:
+     *
+     *   info (1)     Data length. Bit 7 is set on the last record of a save to commit it.
+     *   offset (2)   Where the data goes in the settings image
+     *   epoch (2)    Counts the restarts of the journal
+     *   data (info)
+     *   crc (2)      CRC-16 of the above, with bit 7 of info clear
+     *
+     * The settings are read with the committed records applied over the image
+     * in order. When a save doesn't fit, the records are first folded into the
+     * image and the journal restarts at its beginning with the next epoch, so
+     * all its cells wear alike. A save that is cut short is never committed and
+     * the previous settings remain. A save too big for the journal is written
+     * in place, as without it.
+     */
+
+    #define JOURNAL_HEADER    5                     // info, offset, epoch
+    #define JOURNAL_OVERHEAD  (JOURNAL_HEADER + 2)  // and crc
+    #define JOURNAL_COMMIT    0x80
+
+    static_assert(((sizeof(SettingsData) + EEPROM_OFFSET + 32) & 0xFFF8) + EEPROM_JOURNAL_SIZE <= E2END + 1, "EEPROM_JOURNAL_SIZE is too large for the EEPROM.");
+
+    uint16_t MarlinSettings::journal_end, // = 0
+             MarlinSettings::journal_epoch,
+             MarlinSettings::journal_tail,
+             MarlinSettings::journal_last,
+             MarlinSettings::journal_needed,
+             MarlinSettings::record_offset;
+    bool MarlinSettings::journal_sizing, MarlinSettings::journal_direct;
+    uint8_t MarlinSettings::record_len, MarlinSettings::record_gap, MarlinSettings::record_data[EEPROM_JOURNAL_RECORD_MAX];
+
+    static uint16_t journal_word(const int pos) {
+      return eeprom_read_byte((uint8_t*)pos) | eeprom_read_byte((uint8_t*)(pos + 1)) << 8;
+    }
+
+    uint16_t MarlinSettings::journal_start() { return (datasize() + EEPROM_OFFSET + 32) & 0xFFF8; }
+
+    /**
+     * Find the committed records, checking every one. Reads the journal once at most.
+     */
+    void MarlinSettings::journal_open() {
+      const int start = journal_start();
+      journal_end = 0;
+      for (uint16_t p = 0; p + JOURNAL_OVERHEAD <= EEPROM_JOURNAL_SIZE;) {
+        uint8_t h[JOURNAL_HEADER];
+        for (uint8_t i = 0; i < JOURNAL_HEADER; i++) h[i] = eeprom_read_byte((uint8_t*)(start + p + i));
+        const bool commit = TEST(h[0], 7);
+        const uint8_t len = h[0] & ~JOURNAL_COMMIT;
+        const uint16_t offset = h[1] | h[2] << 8, epoch = h[3] | h[4] << 8, size = JOURNAL_OVERHEAD + len;
+        if (len > EEPROM_JOURNAL_RECORD_MAX || offset + len > datasize() || p + size > EEPROM_JOURNAL_SIZE) break;
+        if (p == 0)
+          journal_epoch = epoch;
+        else if (epoch != journal_epoch)
+          break;                            // Left from before a restart
+
+        uint16_t crc = 0;
+        h[0] = len;
+        crc16(&crc, h, JOURNAL_HEADER);
+        for (uint8_t i = 0; i < len; i++) {
+          const uint8_t c = eeprom_read_byte((uint8_t*)(start + p + JOURNAL_HEADER + i));
+          crc16(&crc, &c, 1);
+        }
+        if (crc != journal_word(start + p + JOURNAL_HEADER + len)) break;
+
+        p += size;
+        if (commit) journal_end = p;
+      }
+    }
+
+    /**
+     * Read bytes of the settings image with the committed records applied
+     */
+    void MarlinSettings::journal_read(const uint16_t offset, uint8_t *dst, const uint8_t n) {
+      for (uint8_t i = 0; i < n; i++) dst[i] = eeprom_read_byte((uint8_t*)(EEPROM_OFFSET + offset + i));
+      const int start = journal_start();
+      for (uint16_t p = 0; p < journal_end;) {
+        const int r = start + p;
+        const uint8_t len = eeprom_read_byte((uint8_t*)r) & ~JOURNAL_COMMIT;
+        const uint16_t r_offset = journal_word(r + 1),
+                       from = MAX(offset, r_offset),
+                       to = MIN(uint16_t(offset + n), uint16_t(r_offset + len));
+        for (uint16_t o = from; o < to; o++)
+          dst[o - offset] = eeprom_read_byte((uint8_t*)(r + JOURNAL_HEADER + o - r_offset));
+        p += JOURNAL_OVERHEAD + len;
+      }
+    }
+
+    /**
+     * Gather the bytes that differ from the stored settings into records
+     */
+    void MarlinSettings::journal_write(uint16_t offset, const uint8_t *value, uint16_t size) {
+      uint8_t stored[16];
+      while (size) {
+        const uint8_t n = size < sizeof(stored) ? size : sizeof(stored);
+        journal_read(offset, stored, n);
+        for (uint8_t i = 0; i < n; i++) journal_put(offset + i, value[i], value[i] != stored[i]);
+        offset += n;
+        value += n;
+        size -= n;
+      }
+    }
+
+    void MarlinSettings::journal_put(const uint16_t offset, const uint8_t b, const bool changed) {
+      if (record_len && (offset != record_offset + record_len || record_len == EEPROM_JOURNAL_RECORD_MAX))
+        journal_close();
+      if (!record_len) {
+        if (!changed) return;
+        record_offset = offset;
+      }
+      record_data[record_len++] = b;
+      if (changed)
+        record_gap = 0;
+      else if (++record_gap == JOURNAL_OVERHEAD)
+        journal_close();                    // A new record costs no more than the gap
+    }
+
+    /**
+     * End the record being gathered. The sizing pass only counts it.
+     */
+    void MarlinSettings::journal_close() {
+      if (!record_len) return;
+      const uint8_t len = record_len - record_gap; // Not the unchanged bytes at the end
+      record_len = record_gap = 0;
+      if (journal_sizing)
+        journal_needed += JOURNAL_OVERHEAD + len;
+      else
+        journal_append(len);
+    }
+
+    void MarlinSettings::journal_append(const uint8_t len) {
+      if (journal_tail + JOURNAL_OVERHEAD + len > EEPROM_JOURNAL_SIZE) {
+        eeprom_error = true;                // The sizing pass made room, so this is a bug
+        return;
+      }
+      uint8_t h[JOURNAL_HEADER] = {
+        len,
+        uint8_t(record_offset & 0xFF), uint8_t(record_offset >> 8),
+        uint8_t(journal_epoch & 0xFF), uint8_t(journal_epoch >> 8)
+      };
+      uint16_t crc = 0, unused_crc;
+      crc16(&crc, h, JOURNAL_HEADER);
+      crc16(&crc, record_data, len);
+      const uint8_t c[2] = { uint8_t(crc & 0xFF), uint8_t(crc >> 8) };
+
+      int pos = journal_start() + journal_tail;
+      write_data(pos, h, JOURNAL_HEADER, &unused_crc);
+      write_data(pos, record_data, len, &unused_crc);
+      write_data(pos, c, 2, &unused_crc);
+
+      journal_last = journal_tail;
+      journal_tail += JOURNAL_OVERHEAD + len;
+    }
+
+    /**
+     * Commit the records of a save by setting bit 7 on the last one,
+     * a single byte write
+     */
+    void MarlinSettings::journal_commit() {
+      journal_close();
+      if (eeprom_error || journal_tail == journal_end) return;
+      int pos = journal_start() + journal_last;
+      const uint8_t info = eeprom_read_byte((uint8_t*)pos) | JOURNAL_COMMIT;
+      uint16_t unused_crc;
+      write_data(pos, &info, 1, &unused_crc);
+      if (!eeprom_error) journal_end = journal_tail;
+    }
+
+    /**
+     * Write the committed records into the settings image and start the
+     * next epoch. The records stay valid until overwritten, so this can be
+     * cut short and done again.
+     */
+    void MarlinSettings::journal_fold() {
+      // Write each byte once, with all the records applied
+      uint8_t buf[16];
+      uint16_t unused_crc;
+      for (uint16_t offset = 0; offset < datasize() && !eeprom_error; offset += sizeof(buf)) {
+        const uint16_t left = datasize() - offset;
+        const uint8_t n = left < sizeof(buf) ? left : sizeof(buf);
+        journal_read(offset, buf, n);
+        int pos = EEPROM_OFFSET + offset;
+        journal_direct = true;
+        write_data(pos, buf, n, &unused_crc);
+        journal_direct = false;
+      }
+      if (!eeprom_error) {
+        journal_epoch++;
+        journal_end = 0;
+      }
+    }
+
+    /**
+     * Drop the records with an empty committed record of the next epoch,
+     * before the settings are written in place
+     */
+    void MarlinSettings::journal_restart() {
+      journal_epoch++;
+      journal_end = journal_tail = 0;
+      record_offset = 0;
+      journal_append(0);
+      journal_commit();
+    }
+
+    /**
+     * Run a save that only counts the bytes of its records, then make room.
+     * Fold the journal if the records don't fit after the committed ones, or
+     * write in place if they don't fit at all.
+     */
+    bool MarlinSettings::journal_prepare() {
+      journal_sizing = true;
+      journal_needed = 0;
+      record_len = record_gap = 0;
+      const bool success = _save();
+      journal_sizing = false;
+      if (!success) return false;
+
+      journal_tail = journal_end;
+      if (journal_needed > EEPROM_JOURNAL_SIZE - journal_end) {
+        if (journal_needed > EEPROM_JOURNAL_SIZE) {
+          journal_restart();
+          journal_direct = true;
+        }
+        else
+          journal_fold();
+        journal_tail = journal_end;
+      }
+      return !eeprom_error;
+    }
+
+  #endif // EEPROM_JOURNAL
+
   /**
    * M500 - Store Configuration
    */
   bool MarlinSettings::save() {
+    #if ENABLED(EEPROM_JOURNAL)
+      eeprom_error = false;
+      if (!journal_prepare()) return false;
+    #endif
+
+    _save();
+
+    #if ENABLED(EEPROM_JOURNAL)
+      journal_direct = false;
+    #endif
+
+    //
+    // UBL Mesh
+    //
+    #if ENABLED(UBL_SAVE_ACTIVE_ON_M500)
+      if (ubl.storage_slot >= 0)
+        store_mesh(ubl.storage_slot);
+    #endif
+
+    return !eeprom_error;
+  }
+
+  bool MarlinSettings::_save() {
     float dummy = 0;
     char ver[4] = "ERR";
 
@@ -439,7 +724,12 @@ void MarlinSettings::postprocess() {
 
     eeprom_error = false;
 
-    EEPROM_WRITE(ver);     // invalidate data first
+    #if ENABLED(EEPROM_JOURNAL)
+      if (!journal_direct)
+        EEPROM_SKIP(ver);   // Records are committed as a whole instead
+      else
+    #endif
+        EEPROM_WRITE(ver);  // invalidate data first
     EEPROM_SKIP(working_crc); // Skip the checksum slot
 
     working_crc = 0; // clear before first "real data"
@@ -1001,25 +1291,29 @@ void MarlinSettings::postprocess() {
       EEPROM_WRITE(version);
       EEPROM_WRITE(final_crc);
 
+      #if ENABLED(EEPROM_JOURNAL)
+        if (journal_sizing) {
+          journal_close();
+          return !size_error(eeprom_size);
+        }
+        if (!journal_direct) journal_commit();
+      #endif
+
       // Report storage size
       #if ENABLED(EEPROM_CHITCHAT)
         SERIAL_ECHO_START();
         SERIAL_ECHOPAIR("Settings Stored (", eeprom_size);
         SERIAL_ECHOPAIR(" bytes; crc ", (uint32_t)final_crc);
+        #if ENABLED(EEPROM_JOURNAL)
+          SERIAL_ECHOPAIR("; journal ", journal_end);
+          SERIAL_ECHOPAIR("/", EEPROM_JOURNAL_SIZE);
+        #endif
         SERIAL_ECHOLNPGM(")");
       #endif
 
       eeprom_error |= size_error(eeprom_size);
     }
 
-    //
-    // UBL Mesh
-    //
-    #if ENABLED(UBL_SAVE_ACTIVE_ON_M500)
-      if (ubl.storage_slot >= 0)
-        store_mesh(ubl.storage_slot);
-    #endif
-
     return !eeprom_error;
   }
 
@@ -1686,6 +1980,9 @@ void MarlinSettings::postprocess() {
   }
 
   bool MarlinSettings::validate() {
+    #if ENABLED(EEPROM_JOURNAL)
+      journal_open();
+    #endif
     validating = true;
     const bool success = _load();
     validating = false;
@@ -1709,8 +2006,12 @@ void MarlinSettings::postprocess() {
     #endif
 
     uint16_t MarlinSettings::meshes_start_index() {
-      return (datasize() + EEPROM_OFFSET + 32) & 0xFFF8;  // Pad the end of configuration data so it can float up
+      return ((datasize() + EEPROM_OFFSET + 32) & 0xFFF8) // Pad the end of configuration data so it can float up
                                                           // or down a little bit without disrupting the mesh data
+        #if ENABLED(EEPROM_JOURNAL)
+          + EEPROM_JOURNAL_SIZE
+        #endif
+      ;
     }
 
     uint16_t MarlinSettings::calc_num_meshes() {
@@ -25,6 +25,10 @@
 
 #include "MarlinConfig.h"
 
+#if ENABLED(EEPROM_JOURNAL)
+  #define EEPROM_JOURNAL_RECORD_MAX 32  // Data bytes in a journal record, up to 127
+#endif
+
 class MarlinSettings {
   public:
     MarlinSettings() { }
@@ -89,7 +93,32 @@ class MarlinSettings {
 
       #endif
 
+      #if ENABLED(EEPROM_JOURNAL)
+        static uint16_t journal_end,      // Bytes of committed records
+                        journal_epoch,    // Epoch of the records since the journal restarted
+                        journal_tail,     // Where the save in progress appends
+                        journal_last,     // The last record it appended
+                        journal_needed;   // Bytes the save needs, found by a sizing pass
+        static bool journal_sizing,       // Only count the bytes a save needs
+                    journal_direct;       // Write the settings in place
+        static uint16_t record_offset;    // The record being gathered
+        static uint8_t record_len, record_gap, record_data[EEPROM_JOURNAL_RECORD_MAX];
+
+        static uint16_t journal_start();
+        static void journal_open();
+        static bool journal_prepare();
+        static void journal_read(const uint16_t offset, uint8_t *dst, const uint8_t n);
+        static void journal_write(uint16_t offset, const uint8_t *value, uint16_t size);
+        static void journal_put(const uint16_t offset, const uint8_t b, const bool changed);
+        static void journal_close();
+        static void journal_append(const uint8_t len);
+        static void journal_commit();
+        static void journal_fold();
+        static void journal_restart();
+      #endif
+
       static bool _load();
+      static bool _save();
       static void write_data(int &pos, const uint8_t *value, uint16_t size, uint16_t *crc);
       static void read_data(int &pos, uint8_t *value, uint16_t size, uint16_t *crc, const bool force=false);
       static bool size_error(const uint16_t size);
@@ -31,6 +31,8 @@
 #ifndef MARLIN_DELAY_H
 #define MARLIN_DELAY_H
 
+#ifdef __AVR__
+
 #define nop() __asm__ __volatile__("nop;\n\t":::)
 
 FORCE_INLINE static void __delay_4cycles(uint8_t cy) {
@@ -68,6 +70,13 @@ FORCE_INLINE static void DELAY_CYCLES(uint16_t x) {
 }
 #undef nop
 
+#else
+
+// Simulated pulses take no time, so there is nothing to wait for
+FORCE_INLINE static void DELAY_CYCLES(uint16_t x) { UNUSED(x); }
+
+#endif // __AVR__
+
 /* ---------------- Delay in nanoseconds */
 #define DELAY_NS(x) DELAY_CYCLES( (x) * (F_CPU/1000000L) / 1000L )
 
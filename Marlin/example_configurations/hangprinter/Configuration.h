@@ -533,6 +533,23 @@
   // Warning: For this to work, don't use decimal points in the ANCHOR_ABCD_XYZ definitions.
   #define CONVENTIONAL_GEOMETRY
 
+  /**
+   * Incremental inverse kinematics
+   * Get each segment's line lengths from the previous segment's, without the
+   * four square roots per segment. The error grows with segment length, so
+   * moves whose estimated error would exceed HANGPRINTER_IK_TOLERANCE keep
+   * using the exact calculation. A higher M665 S gives shorter segments.
+   *
+   * For debugging, HANGPRINTER_IK_CHECK also calculates the exact lengths of
+   * each segment. With M111 S2 the largest difference of each move, and of
+   * all moves so far, is reported.
+   */
+  //#define HANGPRINTER_INCREMENTAL_IK
+  #if ENABLED(HANGPRINTER_INCREMENTAL_IK)
+    #define HANGPRINTER_IK_TOLERANCE 0.001 // (mm) Largest estimated line length error
+    //#define HANGPRINTER_IK_CHECK
+  #endif
+
   /**
    * Line buildup compensation feature
    * For documentation of theory behind, see:
@@ -583,6 +600,16 @@
     #define MOTOR_GEAR_TEETH { 10, 10, 10, 10 }
     #define SPOOL_GEAR_TEETH { 100, 100, 100, 100 }
 
+    /**
+     * Interpolate steps for a line length from a table, instead of taking
+     * a square root for each axis of each move. M665 rebuilds the table and
+     * reports its largest error. Each entry takes 4 bytes of RAM per axis.
+     */
+    //#define LINE_BUILDUP_TABLE
+    #if ENABLED(LINE_BUILDUP_TABLE)
+      #define LINE_BUILDUP_TABLE_SIZE 64 // Intervals from zero to the longest line length. [2-255]
+    #endif
+
   #endif // LINE_BUILDUP_COMPENSATION_FEATURE
 #endif // HANGPRINTER
 
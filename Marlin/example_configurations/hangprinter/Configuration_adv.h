@@ -189,6 +189,12 @@
 #define TEMP_SENSOR_AD8495_OFFSET 0.0
 #define TEMP_SENSOR_AD8495_GAIN   1.0
 
+// Resample thermistor tables at compile time to one entry per ADC count, so a
+// reading converts with a single lookup instead of a binary search.
+// Uses 2050 bytes of PROGMEM for each thermistor type in use. To report the
+// error against the original tables run createTemperatureLookupMarlin.py --check
+//#define UNIFORM_THERMISTOR_TABLES
+
 /**
  * Controller Fan
  * To cool down the stepper drivers and MOSFETs.
@@ -533,6 +539,41 @@
  */
 //#define ADAPTIVE_STEP_SMOOTHING
 
+/**
+ * Step Rate Tables let the planner tabulate each block's acceleration and deceleration
+ * as a few segments of linearly changing step interval, so the Stepper ISR only adds
+ * and compares instead of computing a new step rate and timer interval for every step.
+ * Segments end where the step rate has changed by an equal ratio. The interpolated
+ * interval is never shorter than planned, so the acceleration limit is kept.
+ * A block is tabulated once its plan is final. Blocks that start before that
+ * (e.g., the last blocks of a move) are run from their trapezoid as usual.
+ * Each planner block grows by 26 bytes (AVR) for every segment per ramp.
+ * Not compatible with S_CURVE_ACCELERATION or ADAPTIVE_STEP_SMOOTHING.
+ */
+//#define STEP_RATE_TABLE
+#if ENABLED(STEP_RATE_TABLE)
+  #define STEP_RATE_TABLE_SEGMENTS 8  // Segments per acceleration or deceleration
+#endif
+
+/**
+ * Prepared Blocks let the planner work out what the Stepper ISR sets up at
+ * the start of each block (moving axes, step smoothing, and the initial and
+ * cruise timer intervals) once the block's plan is final. This shortens the
+ * long ISR at every block boundary, which limits the speed of dense G-code.
+ * Blocks that start before they are prepared are set up by the ISR as usual.
+ * Each planner block grows by 11 bytes (12 with ADAPTIVE_STEP_SMOOTHING).
+ */
+//#define PREPARED_BLOCKS
+
+/**
+ * Coalesce Port Writes: Step and direction pins that share an I/O port are
+ * written together, with one atomic write per port instead of one per pin.
+ * This shortens the step pulse phase and removes the skew between the pulses
+ * of motors on the same port. The grouping comes from the board's pins file.
+ * Not compatible with dual steppers, DUAL_X_CARRIAGE, or L6470 drivers.
+ */
+//#define COALESCE_PORT_WRITES
+
 // Microstep setting (Only functional when stepper driver microstep pins are connected to MCU.
 #define MICROSTEP_MODES { 16, 16, 16, 16, 16 } // [1,2,4,8,16]
 
@@ -735,6 +776,34 @@
    */
   //#define AUTO_REPORT_SD_STATUS
 
+  /**
+   * Read the print file ahead into two 512 byte buffers (1K of SRAM), with a
+   * multi-block read of the card. The next block is read while the command
+   * queue is full, and file data isn't evicted by FAT or directory reads.
+   * A contiguous file (e.g., freshly copied to a formatted card) is streamed
+   * from start to end, otherwise the stream restarts at each cluster.
+   */
+  //#define SD_READ_AHEAD
+
+  /**
+   * Index the layers of each print file in a file in the card root, named by
+   * its first cluster (e.g., "00001A2B.IDX"). The index is built on the first
+   * complete print and holds the position, Z and print time of each layer.
+   * Later prints of the file report progress and time left by print time,
+   * and can seek to a layer with M26 L<layer>. Layers are found by absolute
+   * Z moves followed by extrusion.
+   */
+  //#define SD_PRINT_INDEX
+
+  /**
+   * Keep a list of each folder in a file in the card root, named by the first
+   * cluster of the folder (e.g., "00000000.LST" for a FAT16 root). The list is
+   * checked with a single pass over the folder when it's entered, rebuilt when
+   * files have changed, and then used by the LCD file browser instead of
+   * reading the folder once for every name. Speeds up folders with many files.
+   */
+  //#define SD_DIR_CACHE
+
 #endif // SDSUPPORT
 
 /**
@@ -774,6 +843,10 @@
   // Swap the CW/CCW indicators in the graphics overlay
   //#define OVERLAY_GFX_REVERSE
 
+  // Draw only the parts of the Info Screen that have changed, and skip the
+  // update when nothing has. The ST7920 also leaves unchanged stripes alone.
+  //#define DOGM_STATUS_DIRTY_PAGES
+
   #if ENABLED(U8GLIB_ST7920)
     /**
      * ST7920-based LCDs can emulate a 16 x 4 character display using
@@ -874,11 +947,29 @@
   #define N_ARC_CORRECTION   25   // Number of intertpolated segments between corrections
   //#define ARC_P_CIRCLES         // Enable the 'P' parameter to specify complete circles
   //#define CNC_WORKSPACE_PLANES  // Allow G2/G3 to operate in XY, ZX, or YZ planes
+  //#define ARC_CURVE_PLANNING    // Size segments by chord error and also limit their junctions by the arc radius
+  #if ENABLED(ARC_CURVE_PLANNING)
+    #define ARC_CHORD_ERROR     0.01  // (mm) Largest distance between the arc and a segment. Replaces MM_PER_ARC_SEGMENT.
+    #define MIN_ARC_SEGMENT_MM  0.1   // (mm) Shortest segment, for tight arcs
+    #define MAX_ARC_SEGMENT_MM  10    // (mm) Longest segment, for wide arcs
+  #endif
 #endif
 
 // Support for G5 with XYZE destination and IJPQ offsets. Requires ~2666 bytes.
 //#define BEZIER_CURVE_SUPPORT
 
+// Split DELTA and HANGPRINTER moves by how far the joint-space path strays from
+// straight segments. Segments per second (M665 S) becomes the upper limit.
+//#define ADAPTIVE_KINEMATIC_SEGMENTS
+#if ENABLED(ADAPTIVE_KINEMATIC_SEGMENTS)
+  #define KINEMATIC_SEGMENT_ERROR 0.01 // (mm) Largest error of an interpolated joint position
+#endif
+
+// Plan the junctions of DELTA, SCARA and HANGPRINTER segments from their Cartesian
+// directions instead of their joint-space ones, so the segments of a straight line
+// don't slow down where they meet. Requires JUNCTION_DEVIATION.
+//#define CARTESIAN_JUNCTIONS
+
 // G38.2 and G38.3 Probe Target
 // Set MULTIPLE_PROBING if you want G38 to double touch
 //#define G38_PROBE_TARGET
@@ -941,9 +1032,27 @@
 
 // @section hidden
 
+// Deep lookahead for boards with RAM to spare (not AVR). Dense, short-segment
+// G-code needs many blocks of lookahead to reach cruise speed. Each new block
+// is planned incrementally, revisiting at most LOOKAHEAD_REPLAN_MAX blocks.
+//#define DEEP_LOOKAHEAD
+#if ENABLED(DEEP_LOOKAHEAD)
+  #define LOOKAHEAD_REPLAN_MAX 32
+#endif
+
+// Merge a movement into the previous block, while that block is still being
+// planned, if the two go straight on at the same feedrate. Dense G-code made
+// of tiny collinear segments then takes fewer blocks and block changes.
+//#define MERGE_COLLINEAR_BLOCKS
+#if ENABLED(MERGE_COLLINEAR_BLOCKS)
+  #define MERGE_BLOCKS_TOLERANCE 0.01 // (mm) Total deviation allowed from the original path
+#endif
+
 // The number of linear motions that can be in the plan at any give time.
 // THE BLOCK_BUFFER_SIZE NEEDS TO BE A POWER OF 2 (e.g. 8, 16, 32) because shifts and ors are used to do the ring-buffering.
-#if ENABLED(SDSUPPORT)
+#if ENABLED(DEEP_LOOKAHEAD)
+  #define BLOCK_BUFFER_SIZE 128 // 64, 128 or 256
+#elif ENABLED(SDSUPPORT)
   #define BLOCK_BUFFER_SIZE 16 // SD,LCD,Buttons take more memory, block buffer needs to be smaller
 #else
   #define BLOCK_BUFFER_SIZE 16 // maximize block buffer
@@ -955,6 +1064,20 @@
 #define MAX_CMD_SIZE 96
 #define BUFSIZE 4
 
+// Parse commands as they are queued and keep them as letter, code, and
+// fixed-point parameter values, so running them doesn't scan any text.
+// Commands with string arguments (M23, M117...) stay as text.
+// Requires FASTER_GCODE_PARSER.
+//#define PARSED_COMMAND_QUEUE
+
+// Store queued commands end to end in the BUFSIZE * MAX_CMD_SIZE bytes of
+// the command queue, so many more short commands can be buffered from
+// serial and SD. M100 reports the most bytes and commands ever queued.
+//#define COMMAND_ARENA
+#if ENABLED(COMMAND_ARENA)
+  #define COMMAND_ARENA_SLOTS 32 // Maximum number of queued commands (2-255)
+#endif
+
 // Transmission to Host Buffer Size
 // To save 386 bytes of PROGMEM (and TX_BUFFER_SIZE+3 bytes of RAM) set to 0.
 // To buffer a simple "ok" you need 4 bytes.
@@ -1001,6 +1124,32 @@
 // Some clients will have this feature soon. This could make the NO_TIMEOUTS unnecessary.
 //#define ADVANCED_OK
 
+/**
+ * Binary G-code protocol
+ *
+ * Accept G0-G3 moves as compact binary frames alongside ASCII lines, so the
+ * host sends fewer bytes per move and the firmware skips number parsing.
+ * Reported to the host by M115 as "Cap:BINARY_GCODE:1". Hosts that don't
+ * know the capability keep using ASCII, which is always accepted.
+ *
+ * A frame starts where a line would start. All fields are little-endian.
+ *   0xA5            Sync, never the first byte of an ASCII line
+ *   code            G-code number, 0-3. Other codes are refused.
+ *   words           Words present: bit 0-7 = X Y Z E F I J R
+ *   line (2 bytes)  Low 16 bits of the line number, which must follow the last one
+ *   value (4 bytes) For each word present, in order: the value * 1000, signed
+ *   crc (2 bytes)   CRC-16/XMODEM of code..value
+ * Errors are reported and resent like an ASCII line with a bad checksum.
+ * After a bad frame, input is dropped until the host has been quiet for
+ * 200ms, then the resend is requested. A frame that stops partway (e.g.,
+ * a lost byte) is resent after the same 200ms.
+ * Frames are refused while writing a file to SD (M28), and when the move
+ * written as text (e.g., "G1 X-123.456 ...") would exceed MAX_CMD_SIZE.
+ * Requires FASTER_GCODE_PARSER and EXTENDED_CAPABILITIES_REPORT.
+ * Not compatible with EMERGENCY_PARSER, which could act on frame bytes.
+ */
+//#define BINARY_GCODE_PROTOCOL
+
 // @section extras
 
 /**
@@ -1410,6 +1559,19 @@
 //#define EXPERIMENTAL_I2CBUS
 #define I2C_SLAVE_ADDRESS  0 // Set a value from 8 to 127 to act as a slave
 
+/**
+ * Queue I2C transactions and run them from the TWI interrupt instead of waiting
+ * on the Wire library. Mechaduino commands (G95, G96, M114 S1) and I2C position
+ * encoder polling then overlap with planning. Replaces the Wire library, so no
+ * other Wire-based device (e.g., an I2C LCD or digipot) can be used with it.
+ * Master only (I2C_SLAVE_ADDRESS 0).
+ */
+//#define TWIBUS_ASYNC
+#if ENABLED(TWIBUS_ASYNC)
+  #define TWIBUS_QUEUE_SIZE 8     // Transactions waiting for the bus
+  #define TWIBUS_CLOCK 100000     // SCL frequency (Hz)
+#endif
+
 // @section extras
 
 /**
@@ -1510,6 +1672,28 @@
  */
 #define AUTO_REPORT_TEMPERATURES
 
+/**
+ * Profile the time spent in the stepper and temperature ISRs, the planner,
+ * G-code processing and idle(). M102 reports the calls, min/mean/max time,
+ * share of time and a histogram of each section since the last report.
+ * Use M102 S<seconds> to auto-report. Each timed section costs two timer
+ * reads, a few µs on AVR, so leave this disabled for normal printing.
+ */
+//#define PROFILE_HOT_PATHS
+
+/**
+ * Keep the changes of each M500 in a journal after the settings instead of
+ * updating them in place. Only the bytes that changed are written, as small
+ * records spread over the whole journal, so the same cells don't wear at every
+ * save. The journal is written into the settings when it fills up. A save cut
+ * short by a reset is dropped as a whole. Requires EEPROM_SETTINGS.
+ * The journal takes EEPROM space from the UBL mesh slots.
+ */
+//#define EEPROM_JOURNAL
+#if ENABLED(EEPROM_JOURNAL)
+  #define EEPROM_JOURNAL_SIZE 512   // (bytes)
+#endif
+
 /**
  * Include capabilities in M115 output
  */
@@ -1753,6 +1937,36 @@
   //#define E_IS_MECHADUINO
   //#define E_MOTOR_I2C_ADDR 0x0E
   //#define E_INVERT_REPORTED_ANGLE false
+
+  /**
+   * Line length telemetry
+   *
+   * Read the ABCD encoders at a fixed rate while moving and keep the difference
+   * between the line lengths they give and the ones the steppers were at.
+   * Requires TWIBUS_ASYNC, so reading doesn't hold up the main loop.
+   *
+   * M103 S<ms> sets the rate (S0 stops it). M103 sends the samples as one binary frame:
+   *
+   *   0xA5              Sync
+   *   size (u16)        Bytes from count to crc
+   *   count (u8)        Samples in the frame
+   *   axes (u8)         Bits 0-3 are the axes A B C D sampled
+   *   dropped (u16)     Samples overwritten before they were sent
+   *   ms (u32)          Time of the first sample
+   *   First sample:     An error (i16) for each axis, in µm
+   *   Each next sample: The ms since the previous one (u8, 255 = 255 or more) then for
+   *                     each axis the change of its error (i8), -127 to 127, or -128
+   *                     followed by the error (i16)
+   *   crc (u16)         CRC-16/XMODEM of count to the last sample
+   *
+   * Values are little-endian. u8/u16/u32 are unsigned, i8/i16 are signed.
+   * An error of -32768 is a failed read.
+   */
+  //#define MECHADUINO_TELEMETRY
+  #if ENABLED(MECHADUINO_TELEMETRY)
+    #define MECHADUINO_TELEMETRY_INTERVAL 50  // (ms) Default time between samples. 0 to start off.
+    #define MECHADUINO_TELEMETRY_BUFFER   32  // Samples kept until they are sent
+  #endif
 #endif
 
 #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE) || ENABLED(MECHADUINO_I2C_COMMANDS)
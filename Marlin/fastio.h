@@ -83,6 +83,11 @@
 
 #define _TOGGLE(IO)           (DIO ## IO ## _RPORT = _BV(DIO ## IO ## _PIN))
 
+// Set the MASK bits of the port of IO to the bits of V, toggling the differing ones in one write
+#define _WRITE_PORT(IO,MASK,V) (DIO ## IO ## _RPORT = (DIO ## IO ## _WPORT ^ (V)) & (MASK))
+#define _PIN_BIT(IO)          DIO ## IO ## _PIN
+#define _SAME_PORT(IO1,IO2)   (&(DIO ## IO1 ## _RPORT) == &(DIO ## IO2 ## _RPORT))
+
 #define _SET_INPUT(IO)        CBI(DIO ## IO ## _DDR, DIO ## IO ## _PIN)
 #define _SET_OUTPUT(IO)       SBI(DIO ## IO ## _DDR, DIO ## IO ## _PIN)
 
@@ -94,6 +99,10 @@
 #define WRITE(IO,V)           _WRITE(IO,V)
 #define TOGGLE(IO)            _TOGGLE(IO)
 
+#define WRITE_PORT(IO,MASK,V) _WRITE_PORT(IO,MASK,V)
+#define PIN_BIT(IO)           _PIN_BIT(IO)
+#define SAME_PORT(IO1,IO2)    _SAME_PORT(IO1,IO2)
+
 #define SET_INPUT(IO)         _SET_INPUT(IO)
 #define SET_INPUT_PULLUP(IO)  do{ _SET_INPUT(IO); _WRITE(IO, HIGH); }while(0)
 #define SET_OUTPUT(IO)        _SET_OUTPUT(IO)
@@ -133,6 +133,10 @@
 #define MSG_ERR_LINE_NO                     "Line Number is not Last Line Number+1, Last Line: "
 #define MSG_ERR_CHECKSUM_MISMATCH           "checksum mismatch, Last Line: "
 #define MSG_ERR_NO_CHECKSUM                 "No Checksum with line number, Last Line: "
+#define MSG_ERR_BINARY_SD_SAVE              "Binary moves can't be saved to SD, Last Line: "
+#define MSG_ERR_BINARY_CODE                 "Binary frames are G0-G3 only, Last Line: "
+#define MSG_ERR_BINARY_TIMEOUT              "Binary frame incomplete, Last Line: "
+#define MSG_ERR_BINARY_LONG                 "Binary frame too long as text, Last Line: "
 #define MSG_FILE_PRINTED                    "Done printing file"
 #define MSG_BEGIN_FILE_LIST                 "Begin file list"
 #define MSG_END_FILE_LIST                   "End file list"
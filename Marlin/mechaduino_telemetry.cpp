@@ -0,0 +1,208 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mechaduino_telemetry.cpp - Line length errors sampled from the Mechaduino encoders
+ */
+
+#include "MarlinConfig.h"
+
+#if ENABLED(MECHADUINO_TELEMETRY)
+
+#include "mechaduino_telemetry.h"
+#include "Marlin.h"
+#include "planner.h"
+#include "stepper.h"
+#include "utility.h"
+
+MechaduinoTelemetry mechaduino_telemetry;
+
+uint16_t MechaduinoTelemetry::interval_ms = MECHADUINO_TELEMETRY_INTERVAL;
+
+int16_t MechaduinoTelemetry::samples[MECHADUINO_TELEMETRY_BUFFER][ABCD];
+millis_t MechaduinoTelemetry::sample_ms[MECHADUINO_TELEMETRY_BUFFER];
+uint8_t MechaduinoTelemetry::sample_head, // = 0
+        MechaduinoTelemetry::sample_count;
+uint16_t MechaduinoTelemetry::dropped;
+
+volatile uint8_t MechaduinoTelemetry::pending; // = 0
+float MechaduinoTelemetry::angle[ABCD];
+int32_t MechaduinoTelemetry::steps[ABCD];
+uint8_t MechaduinoTelemetry::failed;
+millis_t MechaduinoTelemetry::read_ms, // = 0
+         MechaduinoTelemetry::next_sample_ms;
+
+#define TELEMETRY_AXES (  _BV(A_AXIS) * ENABLED(A_IS_MECHADUINO) \
+                        | _BV(B_AXIS) * ENABLED(B_IS_MECHADUINO) \
+                        | _BV(C_AXIS) * ENABLED(C_IS_MECHADUINO) \
+                        | _BV(D_AXIS) * ENABLED(D_IS_MECHADUINO) )
+
+#define LOOP_TELEMETRY_AXES(VAR) LOOP_MOV_AXIS(VAR) if (TEST(TELEMETRY_AXES, VAR))
+
+static const bool invert_angle[ABCD] = {
+  A_INVERT_REPORTED_ANGLE == INVERT_A_DIR, B_INVERT_REPORTED_ANGLE == INVERT_B_DIR,
+  C_INVERT_REPORTED_ANGLE == INVERT_C_DIR, D_INVERT_REPORTED_ANGLE == INVERT_D_DIR
+};
+
+/**
+ * Take the result of a read. Called from the TWI interrupt.
+ */
+void MechaduinoTelemetry::read_done(const twi_transaction_t &t) {
+  const AxisEnum axis = (AxisEnum)t.tag;
+  if (t.ok && t.count == sizeof(float))
+    memcpy(&angle[axis], t.data, sizeof(float));
+  else
+    SBI(failed, axis);
+  steps[axis] = stepper.position(axis);
+  pending--;
+}
+
+/**
+ * Store the errors of the sample that was read, overwriting the oldest if full
+ */
+void MechaduinoTelemetry::store() {
+  if (sample_count == MECHADUINO_TELEMETRY_BUFFER) {
+    if (++sample_head == MECHADUINO_TELEMETRY_BUFFER) sample_head = 0;
+    sample_count--;
+    if (dropped < 0xFFFF) dropped++;
+  }
+  uint8_t i = sample_head + sample_count;
+  if (i >= MECHADUINO_TELEMETRY_BUFFER) i -= MECHADUINO_TELEMETRY_BUFFER;
+  sample_count++;
+
+  sample_ms[i] = read_ms;
+  LOOP_TELEMETRY_AXES(a) {
+    int16_t &err = samples[i][a];
+    if (TEST(failed, a))
+      err = TELEMETRY_NO_READING;
+    else {
+      const AxisEnum axis = (AxisEnum)a;
+      const float measured = ang_to_mm(invert_angle[a] ? -angle[a] : angle[a], axis),
+                  expected = planner.axis_steps_to_mm(axis, steps[a]) - line_lengths_origin[a],
+                  um = (measured - expected) * 1000.0f;
+      err = um > 32767.0f ? 32767 : um < -32767.0f ? -32767 : (int16_t)LROUND(um);
+    }
+  }
+}
+
+/**
+ * Store the last sample once it's read and start reading the next when due.
+ * The reads are only queued, so this returns while the TWI interrupt does them.
+ */
+void MechaduinoTelemetry::update() {
+  if (pending) return;
+  if (read_ms) {
+    store();
+    read_ms = 0;
+  }
+
+  const millis_t ms = millis();
+  if (!interval_ms || !planner.has_blocks_queued() || !ELAPSED(ms, next_sample_ms)) return;
+  next_sample_ms = ms + interval_ms;
+
+  read_ms = ms ? ms : 1;                // Nonzero while a sample is read
+  failed = 0;
+  pending = 0;
+  LOOP_TELEMETRY_AXES(a) pending++;     // Before queueing, as a read may finish at once
+  #define TELEMETRY_READ(L) TWIBus::queue(L##_MOTOR_I2C_ADDR, NULL, 0, sizeof(float), read_done, L##_AXIS)
+  #if ENABLED(A_IS_MECHADUINO)
+    TELEMETRY_READ(A);
+  #endif
+  #if ENABLED(B_IS_MECHADUINO)
+    TELEMETRY_READ(B);
+  #endif
+  #if ENABLED(C_IS_MECHADUINO)
+    TELEMETRY_READ(C);
+  #endif
+  #if ENABLED(D_IS_MECHADUINO)
+    TELEMETRY_READ(D);
+  #endif
+}
+
+/**
+ * Count the bytes of a frame, or send them and add up their CRC
+ */
+class TelemetryFrame {
+  public:
+    TelemetryFrame(const bool s) : send(s), size(0), crc(0) {}
+    const bool send;
+    uint16_t size, crc;
+
+    void put(const uint8_t b) {
+      size++;
+      if (send) {
+        SERIAL_CHAR(b);
+        crc16(&crc, &b, 1);
+      }
+    }
+    void put16(const uint16_t w) { put(w & 0xFF); put(w >> 8); }
+    void put32(const uint32_t l) { put16(l & 0xFFFF); put16(l >> 16); }
+};
+
+void MechaduinoTelemetry::put_frame(TelemetryFrame &frame) {
+  frame.put(sample_count);
+  frame.put(TELEMETRY_AXES);
+  frame.put16(dropped);
+  frame.put32(sample_count ? sample_ms[sample_head] : 0);
+  for (uint8_t n = 0, i = sample_head, prev = 0; n < sample_count; n++) {
+    if (n) {
+      const millis_t dt = sample_ms[i] - sample_ms[prev];
+      frame.put(dt < 255 ? dt : 255);
+    }
+    LOOP_TELEMETRY_AXES(a) {
+      const int16_t err = samples[i][a];
+      if (n) {
+        const int32_t delta = (int32_t)err - samples[prev][a];
+        if (WITHIN(delta, -127, 127)) {
+          frame.put((int8_t)delta);
+          continue;
+        }
+        frame.put((int8_t)TELEMETRY_ESCAPE);
+      }
+      frame.put16(err);
+    }
+    prev = i;
+    if (++i == MECHADUINO_TELEMETRY_BUFFER) i = 0;
+  }
+}
+
+/**
+ * Send the samples as described for MECHADUINO_TELEMETRY in Configuration_adv.h
+ * and clear the buffer. A newline follows, so the host sees "ok" on its own line.
+ */
+void MechaduinoTelemetry::send_frame() {
+  TelemetryFrame sizing(false), frame(true);
+  put_frame(sizing);
+
+  SERIAL_CHAR(TELEMETRY_SYNC);
+  SERIAL_CHAR(uint8_t((sizing.size + 2) & 0xFF));
+  SERIAL_CHAR(uint8_t((sizing.size + 2) >> 8));
+  put_frame(frame);
+  SERIAL_CHAR(uint8_t(frame.crc & 0xFF));
+  SERIAL_CHAR(uint8_t(frame.crc >> 8));
+  SERIAL_EOL();
+
+  sample_count = 0;
+  dropped = 0;
+}
+
+#endif // MECHADUINO_TELEMETRY
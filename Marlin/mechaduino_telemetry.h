@@ -0,0 +1,72 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * mechaduino_telemetry.h - Line length errors sampled from the Mechaduino encoders
+ *
+ * While the machine moves, the encoder of each Mechaduino is read at a fixed
+ * rate through the TWIBus queue. The line length it gives is compared to the
+ * one the stepper was at when the read finished, and the errors are kept in a
+ * ring buffer until M103 sends them as a binary frame of deltas.
+ */
+
+#ifndef _MECHADUINO_TELEMETRY_H_
+#define _MECHADUINO_TELEMETRY_H_
+
+#include "MarlinConfig.h"
+#include "twibus.h"
+
+#define TELEMETRY_SYNC        0xA5
+#define TELEMETRY_ESCAPE      -128      // In place of a delta too big for a byte, before the error itself
+#define TELEMETRY_NO_READING  -32768    // The error of an axis that didn't answer
+
+class TelemetryFrame;
+
+class MechaduinoTelemetry {
+  public:
+    static uint16_t interval_ms;        // Time between samples. 0 to stop sampling.
+
+    static void update();               // Called from idle()
+    static void send_frame();           // Send the samples and clear the buffer
+
+  private:
+    static int16_t samples[MECHADUINO_TELEMETRY_BUFFER][ABCD];  // Errors in µm
+    static millis_t sample_ms[MECHADUINO_TELEMETRY_BUFFER];
+    static uint8_t sample_head,         // The oldest sample
+                   sample_count;
+    static uint16_t dropped;            // Samples overwritten before they were sent
+
+    // The sample being read, filled in by the TWI interrupt
+    static volatile uint8_t pending;    // Reads still on the bus
+    static float angle[ABCD];
+    static int32_t steps[ABCD];
+    static uint8_t failed;              // Bits of the axes that didn't answer
+    static millis_t read_ms, next_sample_ms;
+
+    static void read_done(const twi_transaction_t &t);
+    static void store();
+    static void put_frame(TelemetryFrame &frame);
+};
+
+extern MechaduinoTelemetry mechaduino_telemetry;
+
+#endif // _MECHADUINO_TELEMETRY_H_
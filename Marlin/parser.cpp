@@ -59,6 +59,10 @@ int GCodeParser::codenum;
   char *GCodeParser::command_args; // start of parameters
 #endif
 
+#if HAS_PACKED_COMMANDS
+  bool GCodeParser::packed_command;
+#endif
+
 // Create a global instance of the GCode parser singleton
 GCodeParser parser;
 
@@ -79,12 +83,19 @@ void GCodeParser::reset() {
     codebits = 0;                       // No codes yet
     //ZERO(param);                      // No parameters (should be safe to comment out this line)
   #endif
+  #if HAS_PACKED_COMMANDS
+    packed_command = false;             // Values are text
+  #endif
 }
 
 // Populate all fields by parsing a single line of GCode
 // 58 bytes of SRAM are used to speed up seen/value
 void GCodeParser::parse(char *p) {
 
+  #if HAS_PACKED_COMMANDS
+    if (*p == PACKED_COMMAND_MARK) return parse_packed(p);
+  #endif
+
   reset(); // No codes to report
 
   // Skip spaces
@@ -228,6 +239,212 @@ void GCodeParser::parse(char *p) {
   }
 }
 
+#if HAS_PACKED_COMMANDS
+
+  static const uint8_t packed_bytes[] = { 0, 1, 2, 4 };
+
+  FORCE_INLINE static const char* next_packed(const char * const p) {
+    return p + 1 + TEST(*p, 7) + packed_bytes[PACKED_SIZE(*p)];
+  }
+
+  // Values are already numbers, so just point each letter at its parameter
+  void GCodeParser::parse_packed(char *p) {
+    reset();
+    packed_command = true;
+    command_ptr = p;
+    command_letter = p[1];
+    codenum = (uint8_t)p[2] | (uint16_t)(uint8_t)p[3] << 8;
+    #if USE_GCODE_SUBCODES
+      subcode = p[4];
+    #endif
+    uint8_t count = p[5];
+    for (p += PACKED_HEADER_SIZE; count--; p = (char*)next_packed(p))
+      set('A' + (*p & 0x1F), p);                // The line number is not A-Z, so it isn't set
+  }
+
+  uint8_t GCodeParser::packed_length(const char * const cmd) {
+    const char *p = cmd + PACKED_HEADER_SIZE;
+    for (uint8_t count = cmd[5]; count--;) p = next_packed(p);
+    return p - cmd;
+  }
+
+  void GCodeParser::pack_param(char* &p, const uint8_t index, int32_t value, uint8_t decimals) {
+    while (decimals && value % 10 == 0) { value /= 10; decimals--; }
+    const uint8_t size = WITHIN(value, -128, 127) ? 1 : WITHIN(value, -32768, 32767) ? 2 : 3;
+    *p++ = index | size << 5 | (decimals ? 0x80 : 0);
+    if (decimals) *p++ = decimals;
+    for (uint8_t i = packed_bytes[size]; i--; value >>= 8) *p++ = value & 0xFF;
+  }
+
+  // Append a character if it fits before the nul, counting it either way
+  FORCE_INLINE static void unpack_char(char * const dst, const uint16_t size, uint16_t &len, const char c) {
+    if (len + 1 < size) dst[len] = c;
+    len++;
+  }
+
+  // Digits of a fixed-point value, with a zero before a leading decimal point
+  static void unpack_value(char * const dst, const uint16_t size, uint16_t &len, const int32_t value, const uint8_t decimals) {
+    char digits[11];
+    uint8_t n = 0;
+    uint32_t u = value < 0 ? -value : value;
+    if (value < 0) unpack_char(dst, size, len, '-');
+    do { digits[n++] = '0' + u % 10; u /= 10; } while (u || n <= decimals);
+    while (n) {
+      if (n == decimals) unpack_char(dst, size, len, '.');
+      unpack_char(dst, size, len, digits[--n]);
+    }
+  }
+
+  uint16_t GCodeParser::unpack(char * const dst, const char *src, const uint16_t size) {
+    uint16_t len = 0;
+    if (*src != PACKED_COMMAND_MARK) {
+      while (*src) unpack_char(dst, size, len, *src++);
+    }
+    else {
+      uint8_t count = src[5], decimals;
+      const char *p = src + PACKED_HEADER_SIZE;
+      if (count && (*p & 0x1F) == PACKED_LINE_NUMBER) {
+        const int32_t value = packed_value(p, decimals);
+        unpack_char(dst, size, len, 'N');
+        unpack_value(dst, size, len, value, decimals);
+        unpack_char(dst, size, len, ' ');
+        p = next_packed(p);
+        count--;
+      }
+      unpack_char(dst, size, len, src[1]);
+      unpack_value(dst, size, len, (uint8_t)src[2] | (uint16_t)(uint8_t)src[3] << 8, 0);
+      if (src[4]) {
+        unpack_char(dst, size, len, '.');
+        unpack_value(dst, size, len, (uint8_t)src[4], 0);
+      }
+      for (; count--; p = next_packed(p)) {
+        unpack_char(dst, size, len, ' ');
+        unpack_char(dst, size, len, 'A' + (*p & 0x1F));
+        if (PACKED_SIZE(*p)) {
+          const int32_t value = packed_value(p, decimals);
+          unpack_value(dst, size, len, value, decimals);
+        }
+      }
+    }
+    if (size) dst[MIN(len, size - 1)] = '\0';
+    return len;
+  }
+
+#endif // HAS_PACKED_COMMANDS
+
+#if ENABLED(PARSED_COMMAND_QUEUE)
+
+  static uint8_t digit_count(uint32_t u) {
+    uint8_t n = 1;
+    for (; u >= 10; u /= 10) n++;
+    return n;
+  }
+
+  /**
+   * Append a [-+]digits[.digits] value as fixed-point, adding the
+   * length of its unpacked text. Fail if it has too many digits.
+   */
+  static bool pack_number(const char* &p, char* &o, const uint8_t index, uint16_t &text_len) {
+    const bool negative = *p == '-';
+    if (*p == '-' || *p == '+') ++p;
+    int32_t value = 0;
+    uint8_t digits = 0, decimals = 0;
+    for (bool point = false;; ++p) {
+      if (*p == '.' && !point)
+        point = true;
+      else if (NUMERIC(*p)) {
+        if ((value || *p != '0') && ++digits > 9) return false;
+        if (point && ++decimals > 9) return false;
+        value = value * 10 + (*p - '0');
+      }
+      else
+        break;
+    }
+    while (decimals && value % 10 == 0) { value /= 10; decimals--; }
+    uint32_t whole = value;
+    for (uint8_t i = decimals; i--;) whole /= 10;
+    text_len += 2 + negative + digit_count(whole) + (decimals ? 1 + decimals : 0);
+    GCodeParser::pack_param(o, index, negative ? -value : value, decimals);
+    return true;
+  }
+
+  // Follows the rules of parse(), giving up on anything it would treat as a string
+  bool GCodeParser::pack(char * const cmd) {
+    char out[MAX_CMD_SIZE], *o = out + PACKED_HEADER_SIZE;
+    const char *p = cmd;
+    uint8_t count = 0;
+    uint16_t text_len = 0;  // Length of the text unpack() would write
+
+    while (*p == ' ') ++p;
+
+    if (*p == 'N' && NUMERIC_SIGNED(p[1])) {
+      ++p;
+      #if ENABLED(ADVANCED_OK)
+        // Keep the line number for ok_to_send()
+        if (!pack_number(p, o, PACKED_LINE_NUMBER, text_len)) return false;
+        count++;
+      #else
+        if (*p == '-') ++p;
+        while (NUMERIC(*p)) ++p;
+      #endif
+      while (*p == ' ') ++p;
+    }
+
+    const char letter = *p++;
+    if (letter != 'G' && letter != 'M' && letter != 'T') return false;
+    while (*p == ' ') ++p;
+    if (!NUMERIC(*p)) return false;
+
+    uint16_t code = 0;
+    do {
+      code = code * 10 + *p++ - '0';
+      if (code > 9999) return false;
+    } while (NUMERIC(*p));
+
+    uint8_t sub = 0;
+    if (*p == '.') {
+      #if USE_GCODE_SUBCODES
+        while (NUMERIC(*++p)) if ((sub = sub * 10 + *p - '0') > 25) return false;
+      #else
+        return false;
+      #endif
+    }
+    text_len += 1 + digit_count(code) + (sub ? 1 + digit_count(sub) : 0);
+
+    if (letter == 'M') switch (code) { case 23: case 28: case 30: case 32: case 33: case 117: case 118: case 928: return false; default: break; }
+
+    while (*p == ' ') ++p;
+    while (*p && *p != '*') {
+      const char c = *p++;
+      if (!WITHIN(c, 'A', 'Z') || c == 'G' || c == 'M') return false; // G53 chains the rest as text
+      if (o > out + MAX_CMD_SIZE - 6) return false;
+      while (*p == ' ') ++p;
+      if (valid_float(p)) {
+        if (!pack_number(p, o, LETTER_BIT(c), text_len)) return false;
+      }
+      else if (letter == 'G') {
+        *o++ = LETTER_BIT(c);
+        text_len += 2;
+      }
+      else
+        return false;                                                 // May be a string, as for M0
+      count++;
+      while (*p == ' ') ++p;
+    }
+    if (text_len >= MAX_CMD_SIZE) return false;
+
+    out[0] = PACKED_COMMAND_MARK;
+    out[1] = letter;
+    out[2] = code & 0xFF;
+    out[3] = code >> 8;
+    out[4] = sub;
+    out[5] = count;
+    memcpy(cmd, out, o - out);
+    return true;
+  }
+
+#endif // PARSED_COMMAND_QUEUE
+
 #if ENABLED(CNC_COORDINATE_SYSTEMS)
 
   // Parse the next parameter as a new command
@@ -250,7 +467,15 @@ void GCodeParser::parse(char *p) {
 
 void GCodeParser::unknown_command_error() {
   SERIAL_ECHO_START();
-  SERIAL_ECHOPAIR(MSG_UNKNOWN_COMMAND, command_ptr);
+  #if HAS_PACKED_COMMANDS
+    if (packed_command) {
+      SERIAL_ECHOPGM(MSG_UNKNOWN_COMMAND);
+      SERIAL_CHAR(command_letter);
+      SERIAL_ECHO(codenum);
+    }
+    else
+  #endif
+      SERIAL_ECHOPAIR(MSG_UNKNOWN_COMMAND, command_ptr);
   SERIAL_CHAR('"');
   SERIAL_EOL();
 }
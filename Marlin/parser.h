@@ -41,6 +41,26 @@
 
 #define strtof strtod
 
+#if ENABLED(BINARY_GCODE_PROTOCOL)
+  #define BINARY_FRAME_SYNC   0xA5        // First byte of a binary frame on the wire
+  #define BINARY_WORDS        "XYZEFIJR"  // Parameter letters, by bit of the words mask
+  #define BINARY_FRAME_TIMEOUT 200       // (ms) Quiet time that ends an incomplete or dropped frame
+#endif
+
+#if HAS_PACKED_COMMANDS
+  /**
+   * A packed command in the queue is PACKED_COMMAND_MARK, the letter, the code
+   * (2 bytes), the subcode and the parameter count. Then for each parameter:
+   *   - The letter index, plus the value size in bits 5-6 and bit 7 if decimals follow
+   *   - The number of decimals, if any
+   *   - The value as a fixed-point integer of 0, 1, 2 or 4 bytes, little-endian
+   */
+  #define PACKED_COMMAND_MARK 0x01        // First byte of a packed command in the queue
+  #define PACKED_HEADER_SIZE  6
+  #define PACKED_LINE_NUMBER  0x1F        // Letter index of the line number, first if present
+  #define PACKED_SIZE(T)      ((T) >> 5 & 0x03)
+#endif
+
 /**
  * GCode parser
  *
@@ -65,6 +85,10 @@ private:
     static char *command_args;      // Args start here, for slow scan
   #endif
 
+  #if HAS_PACKED_COMMANDS
+    static bool packed_command;     // Values are fixed-point, not text
+  #endif
+
 public:
 
   // Global states for GCode-level units features
@@ -147,6 +171,9 @@ public:
           }
         #endif
         char * const ptr = command_ptr + param[ind];
+        #if HAS_PACKED_COMMANDS
+          if (packed_command) value_ptr = PACKED_SIZE(*ptr) ? ptr : (char*)NULL; else
+        #endif
         value_ptr = param[ind] && valid_float(ptr) ? ptr : (char*)NULL;
       }
       return b;
@@ -182,6 +209,38 @@ public:
   // This uses 54 bytes of SRAM to speed up seen/value
   static void parse(char * p);
 
+  #if HAS_PACKED_COMMANDS
+    // Populate all fields from a packed command, without scanning any text
+    static void parse_packed(char * p);
+
+    // Append a parameter to a packed command, as small as the value allows
+    static void pack_param(char* &p, const uint8_t index, int32_t value, uint8_t decimals);
+
+    // Fixed-point value of a packed parameter
+    static int32_t packed_value(const char *p, uint8_t &decimals) {
+      const uint8_t tag = *p++;
+      decimals = TEST(tag, 7) ? *p++ : 0;
+      switch (PACKED_SIZE(tag)) {
+        case 1: return (int8_t)p[0];
+        case 2: return (int16_t)((uint8_t)p[0] | (uint16_t)(uint8_t)p[1] << 8);
+        case 3: return (int32_t)((uint8_t)p[0] | (uint32_t)(uint8_t)p[1] << 8 | (uint32_t)(uint8_t)p[2] << 16 | (uint32_t)(uint8_t)p[3] << 24);
+        default: return 0;
+      }
+    }
+
+    // Write a command as text, unpacking it if needed. Like snprintf, write
+    // no more than size bytes, nul included, and return the full text length.
+    static uint16_t unpack(char * const dst, const char *src, const uint16_t size);
+
+    // Bytes taken up by a packed command
+    static uint8_t packed_length(const char * const cmd);
+  #endif
+
+  #if ENABLED(PARSED_COMMAND_QUEUE)
+    // Pack a queued text command in place. Commands with strings stay as text.
+    static bool pack(char * const cmd);
+  #endif
+
   #if ENABLED(CNC_COORDINATE_SYSTEMS)
     // Parse the next parameter as a new command
     static bool chain();
@@ -195,6 +254,16 @@ public:
 
   // Float removes 'E' to prevent scientific notation interpretation
   inline static float value_float() {
+    #if HAS_PACKED_COMMANDS
+      if (packed_command) {
+        if (!value_ptr) return 0;
+        uint8_t decimals;
+        const float value = packed_value(value_ptr, decimals);
+        float scale = 1;
+        while (decimals--) scale *= 10;
+        return value / scale;
+      }
+    #endif
     if (value_ptr) {
       char *e = value_ptr;
       for (;;) {
@@ -214,8 +283,21 @@ public:
   }
 
   // Code value as a long or ulong
-  inline static int32_t value_long() { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
-  inline static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  #if HAS_PACKED_COMMANDS
+    // Truncated like strtol, which stops at the decimal point
+    inline static int32_t packed_long() {
+      if (!value_ptr) return 0;
+      uint8_t decimals;
+      int32_t value = packed_value(value_ptr, decimals);
+      while (decimals--) value /= 10;
+      return value;
+    }
+    inline static int32_t value_long() { return packed_command ? packed_long() : value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
+    inline static uint32_t value_ulong() { return packed_command ? (uint32_t)packed_long() : value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  #else
+    inline static int32_t value_long() { return value_ptr ? strtol(value_ptr, NULL, 10) : 0L; }
+    inline static uint32_t value_ulong() { return value_ptr ? strtoul(value_ptr, NULL, 10) : 0UL; }
+  #endif
 
   // Code value for use as time
   FORCE_INLINE static millis_t value_millis() { return value_ulong(); }
@@ -81,6 +81,10 @@
   #include "power.h"
 #endif
 
+#if ENABLED(PROFILE_HOT_PATHS)
+  #include "profiler.h"
+#endif
+
 // Delay for delivery of first block to the stepper ISR, if the queue contains 2 or
 // fewer movements. The delay is measured in milliseconds, and must be less than 250ms
 #define BLOCK_DELAY_FOR_1ST_MOVE 100
@@ -97,6 +101,9 @@ volatile uint8_t Planner::block_buffer_head,    // Index of the next block to be
                  Planner::block_buffer_nonbusy, // Index of the first non-busy block
                  Planner::block_buffer_planned, // Index of the optimally planned block
                  Planner::block_buffer_tail;    // Index of the busy block, if any
+#if ENABLED(DEEP_LOOKAHEAD)
+  uint8_t Planner::block_buffer_replan;         // Index of the oldest block changed by the last reverse pass
+#endif
 uint16_t Planner::cleaning_buffer_counter;      // A counter to disable queuing of blocks
 uint8_t Planner::delay_before_delivering;       // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
@@ -126,11 +133,20 @@ float Planner::max_feedrate_mm_s[NUM_AXIS_N], // (mm/s) M203 XYZE - Max speeds
   float Planner::max_jerk[NUM_AXIS];          // (mm/s^2) M205 XYZE - The largest speed change requiring no acceleration.
 #endif
 
+#if ENABLED(ARC_CURVE_PLANNING)
+  float Planner::arc_radius;                  // (mm) Radius of the arc joining the next block to the last, 0 for a corner
+#endif
+
 #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
   float Planner::k0[MOV_AXIS],
         Planner::k1[MOV_AXIS],
         Planner::k2[MOV_AXIS],
         Planner::sqrtk1[MOV_AXIS];
+  #if ENABLED(LINE_BUILDUP_TABLE)
+    float Planner::buildup_table[MOV_AXIS][LINE_BUILDUP_TABLE_SIZE + 1],
+          Planner::buildup_table_scale[MOV_AXIS],
+          Planner::buildup_table_error;
+  #endif
 #endif
 
 #if ENABLED(ABORT_ON_ENDSTOP_HIT_FEATURE_ENABLED)
@@ -197,8 +213,28 @@ uint32_t Planner::cutoff_long;
 float Planner::previous_speed[NUM_AXIS],
       Planner::previous_nominal_speed_sqr;
 
+#if ENABLED(CARTESIAN_JUNCTIONS)
+  float Planner::position_cart[XYZE],
+        Planner::cartesian_unit_vec[XYZE],
+        Planner::previous_cartesian_unit_vec[XYZE];
+  bool Planner::position_cart_known, // = false
+       Planner::cartesian_move,
+       Planner::cartesian_dir_known,
+       Planner::previous_cartesian_dir_known;
+#endif
+
+#if ENABLED(MERGE_COLLINEAR_BLOCKS)
+  float Planner::merge_start[NUM_AXIS],
+        Planner::merge_deviation,
+        Planner::merge_fr_mm_s;
+#endif
+
 #if ENABLED(DISABLE_INACTIVE_EXTRUDER)
-  uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  #if BLOCK_BUFFER_SIZE >= 128
+    uint16_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  #else
+    uint8_t Planner::g_uc_extruder_last_move[EXTRUDERS] = { 0 };
+  #endif
 #endif
 
 #ifdef XY_FREQUENCY_LIMIT
@@ -322,6 +358,13 @@ void Planner::init() {
    *  return uint32_t(x);                                             // x holds the proper estimation
    *
    */
+  #ifndef __AVR__
+
+  // Without an 8-bit multiplier to work around, a plain division will do
+  static uint32_t get_period_inverse(const uint32_t d) { return d ? 0xFFFFFF / d : 0xFFFFFF; }
+
+  #else
+
   static uint32_t get_period_inverse(uint32_t d) {
 
     static const uint8_t inv_tab[256] PROGMEM = {
@@ -686,6 +729,8 @@ void Planner::init() {
     return r11 | (uint16_t(r12) << 8) | (uint32_t(r13) << 16);
   }
 
+  #endif // __AVR__
+
 #endif // S_CURVE_ACCELERATION
 
 #define MINIMAL_STEP_RATE 120
@@ -762,6 +807,13 @@ void Planner::calculate_trapezoid_for_block(block_t* const block, const float &e
     block->cruise_rate = cruise_rate;
   #endif
   block->final_rate = final_rate;
+
+  #if ENABLED(STEP_RATE_TABLE)
+    CBI(block->flag, BLOCK_BIT_RATE_TABLE);
+  #endif
+  #if ENABLED(PREPARED_BLOCKS)
+    CBI(block->flag, BLOCK_BIT_PREPARED);
+  #endif
 }
 
 /*                            PLANNER SPEED DEFINITION
@@ -891,6 +943,11 @@ void Planner::reverse_pass() {
   //  planning already consumed blocks
   if (planned_block_index == block_buffer_head) return;
 
+  #if ENABLED(DEEP_LOOKAHEAD)
+    // Bound the work done for a single new block
+    uint8_t replan_count = LOOKAHEAD_REPLAN_MAX;
+  #endif
+
   // Reverse Pass: Coarsely maximize all possible deceleration curves back-planning from the last
   // block in buffer. Cease planning when the last optimal planned or tail pointer is reached.
   // NOTE: Forward pass will later refine and correct the reverse pass to create an optimal plan.
@@ -902,7 +959,22 @@ void Planner::reverse_pass() {
 
     // Only consider non sync blocks
     if (!TEST(current->flag, BLOCK_BIT_SYNC_POSITION)) {
+      #if ENABLED(DEEP_LOOKAHEAD)
+        const float old_entry_speed_sqr = current->entry_speed_sqr;
+      #endif
+
       reverse_pass_kernel(current, next);
+
+      #if ENABLED(DEEP_LOOKAHEAD)
+        // Earlier blocks only depend on this entry speed. If it didn't change,
+        // their plan can't change either (the newest block has no plan yet).
+        // Past the bound, earlier blocks keep their lower (so still safe)
+        // entry speeds until the next new block.
+        if (next && current->entry_speed_sqr == old_entry_speed_sqr) return;
+        block_buffer_replan = block_index;
+        if (!--replan_count) return;
+      #endif
+
       next = current;
     }
 
@@ -973,6 +1045,24 @@ void Planner::forward_pass_kernel(const block_t* const previous, block_t* const
   }
 }
 
+#if ENABLED(DEEP_LOOKAHEAD)
+
+  /**
+   * The first non-SYNC block before the oldest one changed by the last reverse
+   * pass. Replanning resumes there, since the blocks before it can't be changed
+   * by new blocks. Returns 'first' if there is no such block in [first, head).
+   */
+  uint8_t Planner::replan_start(const uint8_t first, const uint8_t head) {
+    uint8_t b = prev_block_index(block_buffer_replan);
+    while (BLOCK_MOD(b - first) < BLOCK_MOD(head - first)) {
+      if (!TEST(block_buffer[b].flag, BLOCK_BIT_SYNC_POSITION)) return b;
+      b = prev_block_index(b);
+    }
+    return first;
+  }
+
+#endif // DEEP_LOOKAHEAD
+
 /**
  * recalculate() needs to go over the current plan twice.
  * Once in reverse and once forward. This implements the forward pass.
@@ -986,7 +1076,14 @@ void Planner::forward_pass() {
   //  by the stepper ISR,  so read it ONCE. It it guaranteed that block_buffer_planned
   //  will never lead head, so the loop is safe to execute. Also note that the forward
   //  pass will never modify the values at the tail.
-  uint8_t block_index = block_buffer_planned;
+  uint8_t block_index = (
+    #if ENABLED(DEEP_LOOKAHEAD)
+      // Blocks before the ones changed by the reverse pass are already forward planned
+      replan_start(block_buffer_planned, block_buffer_head)
+    #else
+      block_buffer_planned
+    #endif
+  );
 
   block_t *current;
   const block_t * previous = NULL;
@@ -1018,8 +1115,15 @@ void Planner::forward_pass() {
  */
 void Planner::recalculate_trapezoids() {
   // The tail may be changed by the ISR so get a local copy.
-  uint8_t block_index = block_buffer_tail,
-          head_block_index = block_buffer_head;
+  uint8_t head_block_index = block_buffer_head,
+          block_index = (
+            #if ENABLED(DEEP_LOOKAHEAD)
+              // Only blocks from the one before the oldest changed block can need new trapezoids
+              replan_start(block_buffer_tail, head_block_index)
+            #else
+              block_buffer_tail
+            #endif
+          );
   // Since there could be a sync block in the head of the queue, and the
   // next loop must not recalculate the head block (as it needs to be
   // specially handled), scan backwards to the first non-SYNC block.
@@ -1123,16 +1227,69 @@ void Planner::recalculate_trapezoids() {
 }
 
 void Planner::recalculate() {
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_RECALCULATE);
+  #endif
+
   // Initialize block index to the last block in the planner buffer.
   const uint8_t block_index = prev_block_index(block_buffer_head);
+  #if ENABLED(DEEP_LOOKAHEAD)
+    block_buffer_replan = block_index; // The reverse pass moves it back
+  #endif
   // If there is just one block, no planning can be done. Avoid it!
   if (block_index != block_buffer_planned) {
     reverse_pass();
     forward_pass();
   }
   recalculate_trapezoids();
+  #if ENABLED(STEP_RATE_TABLE)
+    tabulate_planned_blocks();
+  #endif
+  #if ENABLED(PREPARED_BLOCKS)
+    prepare_planned_blocks();
+  #endif
 }
 
+#if ENABLED(STEP_RATE_TABLE)
+
+  /**
+   * Fill the rate tables of the blocks the planner won't change anymore.
+   * Each block is tabulated once, instead of on every recalculation.
+   * A block reaching the Stepper ISR without a table uses the trapezoid.
+   */
+  void Planner::tabulate_planned_blocks() {
+    // The ISR may advance both indexes, so read them once. The planned
+    // index never falls behind the nonbusy index, so read it last.
+    uint8_t block_index = block_buffer_nonbusy;
+    const uint8_t planned_block_index = block_buffer_planned;
+    for (; block_index != planned_block_index; block_index = next_block_index(block_index)) {
+      block_t * const block = &block_buffer[block_index];
+      if (!(block->flag & (BLOCK_FLAG_SYNC_POSITION | BLOCK_FLAG_RATE_TABLE)) && !stepper.is_block_busy(block))
+        stepper.calculate_rate_table(block);
+    }
+  }
+
+#endif
+
+#if ENABLED(PREPARED_BLOCKS)
+
+  /**
+   * Prepare the Stepper ISR setup of the blocks the planner won't change anymore,
+   * so the ISR doesn't have to work it out when the block starts.
+   */
+  void Planner::prepare_planned_blocks() {
+    // Read the indexes as in tabulate_planned_blocks
+    uint8_t block_index = block_buffer_nonbusy;
+    const uint8_t planned_block_index = block_buffer_planned;
+    for (; block_index != planned_block_index; block_index = next_block_index(block_index)) {
+      block_t * const block = &block_buffer[block_index];
+      if (!(block->flag & (BLOCK_FLAG_SYNC_POSITION | BLOCK_FLAG_PREPARED)) && !stepper.is_block_busy(block))
+        stepper.prepare_block(block);
+    }
+  }
+
+#endif
+
 #if ENABLED(AUTOTEMP)
 
   void Planner::getHighESpeed() {
@@ -1530,10 +1687,7 @@ float Planner::get_axis_position_mm(const AxisEnum axis) {
   #else
     axis_steps = stepper.position(axis);
   #endif
-  #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
-    if (axis != E_AXIS) return (sq(axis_steps / k0[axis] + sqrtk1[axis]) - k1[axis]) / k2[axis];
-  #endif
-  return axis_steps * steps_to_mm[axis];
+  return axis_steps_to_mm(axis, axis_steps);
 }
 
 /**
@@ -1574,9 +1728,19 @@ bool Planner::_buffer_steps(const int32_t (&target)[NUM_AXIS]
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
-  // Wait for the next available block
   uint8_t next_buffer_head;
-  block_t * const block = get_next_free_block(next_buffer_head);
+  #if ENABLED(MERGE_COLLINEAR_BLOCKS)
+    // The head block is unused even when the buffer is full. Fill it before
+    // waiting for room, as the movement may just extend the previous block.
+    block_t * const block = &block_buffer[block_buffer_head];
+    int32_t step_start[NUM_AXIS];
+    float segment_start[NUM_AXIS];
+    COPY(step_start, position);
+    COPY(segment_start, position_float);
+  #else
+    // Wait for the next available block
+    block_t * const block = get_next_free_block(next_buffer_head);
+  #endif
 
   // Fill the block with the specified movement
   if (!_populate_block(block, false, target
@@ -1593,6 +1757,27 @@ bool Planner::_buffer_steps(const int32_t (&target)[NUM_AXIS]
     return true;
   }
 
+  #if ENABLED(MERGE_COLLINEAR_BLOCKS)
+    if (merge_into_previous(block, segment_start, fr_mm_s)) {
+      recalculate();
+      return true;
+    }
+
+    // Wait for the next available block. Drop the movement if the queue was cleared meanwhile,
+    // and take back the position _populate_block already moved on, as if it had never come.
+    get_next_free_block(next_buffer_head);
+    if (cleaning_buffer_counter) {
+      COPY(position, step_start);
+      COPY(position_float, segment_start);
+      return false;
+    }
+
+    // The next segment may be merged into this block
+    COPY(merge_start, segment_start);
+    merge_deviation = 0;
+    merge_fr_mm_s = fr_mm_s;
+  #endif
+
   // If this is the first added movement, reload the delay, otherwise, cancel it.
   if (block_buffer_head == block_buffer_tail) {
     // If it was the first queued block, restart the 1st block delivery delay, to
@@ -2257,6 +2442,11 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   float vmax_junction_sqr; // Initial limit on the segment entry velocity (mm/s)^2
 
+  #if ENABLED(CARTESIAN_JUNCTIONS)
+    // Both segments are kinematic, so plan the junction from their Cartesian directions
+    const bool cartesian_junction = cartesian_dir_known && previous_cartesian_dir_known;
+  #endif
+
   #if ENABLED(JUNCTION_DEVIATION)
 
     /**
@@ -2303,14 +2493,24 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
       delta_mm[E_AXIS] * inverse_millimeters
     };
 
+    // The directions meeting at the junction
+    #if ENABLED(CARTESIAN_JUNCTIONS)
+      // Kinematic segments meet along the Cartesian path
+      const float (&dir)[XYZE] = cartesian_junction ? cartesian_unit_vec : unit_vec,
+                  (&previous_dir)[XYZE] = cartesian_junction ? previous_cartesian_unit_vec : previous_unit_vec;
+    #else
+      const float (&dir)[XYZE] = unit_vec,
+                  (&previous_dir)[XYZE] = previous_unit_vec;
+    #endif
+
     // Skip first block or when previous_nominal_speed is used as a flag for homing and offset cycles.
     if (moves_queued && !UNEAR_ZERO(previous_nominal_speed_sqr)) {
       // Compute cosine of angle between previous and current path. (prev_unit_vec is negative)
       // NOTE: Max junction velocity is computed without sin() or acos() by trig half angle identity.
-      float junction_cos_theta = -previous_unit_vec[X_AXIS] * unit_vec[X_AXIS]
-                                 -previous_unit_vec[Y_AXIS] * unit_vec[Y_AXIS]
-                                 -previous_unit_vec[Z_AXIS] * unit_vec[Z_AXIS]
-                                 -previous_unit_vec[E_AXIS] * unit_vec[E_AXIS]
+      float junction_cos_theta = -previous_dir[X_AXIS] * dir[X_AXIS]
+                                 -previous_dir[Y_AXIS] * dir[Y_AXIS]
+                                 -previous_dir[Z_AXIS] * dir[Z_AXIS]
+                                 -previous_dir[E_CART] * dir[E_CART]
                                 ;
 
       // NOTE: Computed without any expensive trig, sin() or acos(), by trig half angle identity of cos(theta).
@@ -2323,17 +2523,35 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
         // Convert delta vector to unit vector
         float junction_unit_vec[XYZE] = {
-          unit_vec[X_AXIS] - previous_unit_vec[X_AXIS],
-          unit_vec[Y_AXIS] - previous_unit_vec[Y_AXIS],
-          unit_vec[Z_AXIS] - previous_unit_vec[Z_AXIS],
-          unit_vec[E_AXIS] - previous_unit_vec[E_AXIS]
+          dir[X_AXIS] - previous_dir[X_AXIS],
+          dir[Y_AXIS] - previous_dir[Y_AXIS],
+          dir[Z_AXIS] - previous_dir[Z_AXIS],
+          dir[E_CART] - previous_dir[E_CART]
         };
         normalize_junction_vector(junction_unit_vec);
 
-        const float junction_acceleration = limit_value_by_axis_maximum(block->acceleration, junction_unit_vec),
+        const float junction_acceleration = (
+                      #if ENABLED(CARTESIAN_JUNCTIONS)
+                        // The joint limits are already in the block's acceleration
+                        cartesian_junction ? block->acceleration :
+                      #endif
+                      limit_value_by_axis_maximum(block->acceleration, junction_unit_vec)
+                    ),
                     sin_theta_d2 = SQRT(0.5f * (1.0f - junction_cos_theta)); // Trig half angle identity. Always positive.
 
         vmax_junction_sqr = (junction_acceleration * junction_deviation_mm * sin_theta_d2) / (1.0f - sin_theta_d2);
+        #if ENABLED(CARTESIAN_JUNCTIONS)
+          if (cartesian_junction) {
+            // The Cartesian path turns by an exact angle, none at all along a straight line. Take it from
+            // the half angle identity instead of the acos error bar, so the arc limit fades out smoothly.
+            const float sin_turn_d2 = SQRT(0.5f * (1.0f + junction_cos_theta)); // Always positive after the clamp above.
+            if (block->millimeters < 1 && sin_turn_d2 < 0.38268343f) { // Turning less than 45 degrees (octagon)
+              const float limit_sqr = block->millimeters / (2.0f * sin_turn_d2) * junction_acceleration;
+              NOMORE(vmax_junction_sqr, limit_sqr);
+            }
+          }
+          else
+        #endif
         if (block->millimeters < 1) {
 
           // Fast acos approximation, minus the error bar to be safe
@@ -2424,6 +2642,7 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
         }
       }
       if (limited) vmax_junction *= v_factor;
+
       // Now the transition velocity is known, which maximizes the shared exit / entry velocity while
       // respecting the jerk factors, it may be possible, that applying separate safe exit / entry velocities will achieve faster prints.
       const float vmax_junction_threshold = vmax_junction * 0.99f;
@@ -2438,6 +2657,12 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
 
   #endif // Classic Jerk Limiting
 
+  #if ENABLED(ARC_CURVE_PLANNING)
+    // Chords of one arc also follow its curvature, so the centripetal acceleration limits the junction too.
+    // The velocity still turns at each chord's vertex, so this never raises the jerk or junction deviation limit.
+    if (arc_radius) NOMORE(vmax_junction_sqr, block->acceleration * arc_radius);
+  #endif
+
   // Max entry speed of this block equals the max exit speed of the previous block.
   block->max_entry_speed_sqr = vmax_junction_sqr;
 
@@ -2462,6 +2687,13 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   COPY(previous_speed, current_speed);
   previous_nominal_speed_sqr = block->nominal_speed_sqr;
 
+  #if ENABLED(CARTESIAN_JUNCTIONS)
+    COPY(previous_cartesian_unit_vec, cartesian_unit_vec);
+    previous_cartesian_dir_known = cartesian_dir_known;
+    if (!cartesian_move) position_cart_known = false; // A joint-space move leaves the Cartesian path
+    cartesian_move = cartesian_dir_known = false;
+  #endif
+
   // Update the position (only when a move was queued)
   static_assert(COUNT(target) > 1, "Parameter to _populate_block must be (&target)["
     #if ENABLED(HANGPRINTER)
@@ -2483,6 +2715,133 @@ bool Planner::_populate_block(block_t * const block, bool split_move,
   return true;
 } // _populate_block()
 
+#if ENABLED(MERGE_COLLINEAR_BLOCKS)
+
+  /**
+   * Planner::merge_into_previous
+   *
+   * Extend the previous block with a new one, if the previous block isn't
+   * optimally planned yet, and the two continue in a straight line with the
+   * same feedrate. Then one block does the work of many short segments.
+   *
+   *  block         - the filled, but not queued, new block
+   *  segment_start - where the new block starts, in planner units
+   *  fr_mm_s       - the feedrate requested for the new block
+   *
+   * Returns true if the new block was merged, and mustn't be queued
+   */
+  bool Planner::merge_into_previous(const block_t * const block, const float (&segment_start)[NUM_AXIS], const float &fr_mm_s) {
+    block_t * const prev = &block_buffer[prev_block_index(block_buffer_head)];
+
+    // The blocks must run the same steppers the same way with the same settings
+    if (fr_mm_s != merge_fr_mm_s
+      || TEST(prev->flag, BLOCK_BIT_SYNC_POSITION)
+      || prev->direction_bits != block->direction_bits
+      || prev->active_extruder != block->active_extruder
+      #if ENABLED(UNREGISTERED_MOVE_SUPPORT)
+        || !prev->count_it || !block->count_it
+      #endif
+      #if ENABLED(LIN_ADVANCE)
+        || prev->use_advance_lead != block->use_advance_lead
+      #endif
+      #if ENABLED(BARICUDA)
+        || prev->valve_pressure != block->valve_pressure
+        || prev->e_to_p_pressure != block->e_to_p_pressure
+      #endif
+    ) return false;
+
+    #if FAN_COUNT > 0
+      for (uint8_t i = 0; i < FAN_COUNT; i++) if (prev->fan_speed[i] != block->fan_speed[i]) return false;
+    #endif
+
+    // The merged block runs straight from merge_start to the new end, cutting
+    // the joint of the two. Add up how far each cut joint is from the path.
+    // E counts too, so printing doesn't merge with travel.
+    float joint[NUM_AXIS], chord[NUM_AXIS], joint_dot_chord = 0, chord_sq = 0;
+    LOOP_NUM_AXIS(i) {
+      joint[i] = segment_start[i] - merge_start[i];
+      chord[i] = position_float[i] - merge_start[i];
+      joint_dot_chord += joint[i] * chord[i];
+      chord_sq += sq(chord[i]);
+    }
+    if (UNEAR_ZERO(chord_sq)) return false;
+    const float t = joint_dot_chord / chord_sq;
+    if (!WITHIN(t, 0, 1)) return false;
+    float offset_sq = 0;
+    LOOP_NUM_AXIS(i) offset_sq += sq(joint[i] - t * chord[i]);
+    const float deviation = merge_deviation + SQRT(offset_sq);
+    if (deviation > MERGE_BLOCKS_TOLERANCE) return false;
+
+    // Keep the Stepper ISR off the previous block until it's recalculated,
+    // unless the ISR already has it or it's optimally planned
+    const bool was_enabled = STEPPER_ISR_ENABLED();
+    if (was_enabled) DISABLE_STEPPER_DRIVER_INTERRUPT();
+    const bool unplanned = block_buffer_planned != block_buffer_head;
+    if (unplanned) SBI(prev->flag, BLOCK_BIT_RECALCULATE);
+    if (was_enabled) ENABLE_STEPPER_DRIVER_INTERRUPT();
+    if (!unplanned) return false;
+
+    uint32_t step_event_count = 0;
+    LOOP_NUM_AXIS(i) {
+      prev->steps[i] += block->steps[i];
+      NOLESS(step_event_count, prev->steps[i]);
+    }
+    prev->step_event_count = step_event_count;
+    #if ENABLED(MIXING_EXTRUDER)
+      for (uint8_t i = 0; i < MIXING_STEPPERS; i++) prev->mix_steps[i] += block->mix_steps[i];
+    #endif
+    prev->millimeters += block->millimeters;
+    prev->segment_time_us += block->segment_time_us;
+
+    // Limit the requested feedrate for the merged block like _populate_block does.
+    // SLOWDOWN is left out, as the merged block is longer than the short moves it's for.
+    const uint8_t e_index = E_AXIS
+      #if ENABLED(DISTINCT_E_FACTORS)
+        + prev->active_extruder
+      #endif
+    ;
+    float nominal_speed = MAX(fr_mm_s, prev->steps[E_AXIS] ? min_feedrate_mm_s : min_travel_feedrate_mm_s),
+          speed_factor = 1.0f;
+    const float inverse_secs = nominal_speed / prev->millimeters;
+    LOOP_NUM_AXIS(i) {
+      const uint8_t index = i == E_AXIS ? e_index : i;
+      const float cs = prev->steps[i] * steps_to_mm[index] * inverse_secs;
+      if (cs > max_feedrate_mm_s[index]) NOMORE(speed_factor, max_feedrate_mm_s[index] / cs);
+    }
+    nominal_speed *= speed_factor;
+    LOOP_NUM_AXIS(i) previous_speed[i] *= nominal_speed / SQRT(block->nominal_speed_sqr);
+    prev->nominal_speed_sqr = sq(nominal_speed);
+
+    // Use the lower acceleration of the two
+    if (block->acceleration < prev->acceleration) {
+      prev->acceleration = block->acceleration;
+      #if ENABLED(LIN_ADVANCE)
+        prev->advance_speed = block->advance_speed;
+      #endif
+    }
+    const float steps_per_mm = step_event_count / prev->millimeters;
+    prev->nominal_rate = CEIL(nominal_speed * steps_per_mm);
+    prev->acceleration_steps_per_s2 = prev->acceleration * steps_per_mm;
+    #if DISABLED(S_CURVE_ACCELERATION)
+      prev->acceleration_rate = (uint32_t)(prev->acceleration_steps_per_s2 * (4096.0f * 4096.0f / (STEPPER_TIMER_RATE)));
+    #endif
+    NOMORE(prev->max_entry_speed_sqr, prev->nominal_speed_sqr);
+    NOMORE(prev->entry_speed_sqr, prev->max_entry_speed_sqr);
+
+    // The longer block may now reach its nominal speed from a stop
+    if (prev->nominal_speed_sqr <= max_allowable_speed_sqr(-prev->acceleration, sq(float(MINIMUM_PLANNER_SPEED)), prev->millimeters))
+      SBI(prev->flag, BLOCK_BIT_NOMINAL_LENGTH);
+    else
+      CBI(prev->flag, BLOCK_BIT_NOMINAL_LENGTH);
+
+    // The next junction is with the merged block
+    previous_nominal_speed_sqr = prev->nominal_speed_sqr;
+    merge_deviation = deviation;
+    return true;
+  }
+
+#endif // MERGE_COLLINEAR_BLOCKS
+
 /**
  * Planner::buffer_sync_block
  * Add a block to the buffer that just updates the position
@@ -2542,6 +2901,10 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c
   #endif
 ) {
 
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_BUFFER_SEGMENT);
+  #endif
+
   // If we are cleaning, do not accept queuing of movements
   if (cleaning_buffer_counter) return false;
 
@@ -2557,10 +2920,10 @@ bool Planner::buffer_segment(const float &a, const float &b, const float &c
   // Calculate target position in absolute steps
   const int32_t target[NUM_AXIS] = {
     #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
-      LROUND(k0[A_AXIS] * (SQRT(k1[A_AXIS] + a * k2[A_AXIS]) - sqrtk1[A_AXIS])),
-      LROUND(k0[B_AXIS] * (SQRT(k1[B_AXIS] + b * k2[B_AXIS]) - sqrtk1[B_AXIS])),
-      LROUND(k0[C_AXIS] * (SQRT(k1[C_AXIS] + c * k2[C_AXIS]) - sqrtk1[C_AXIS])),
-      LROUND(k0[D_AXIS] * (SQRT(k1[D_AXIS] + d * k2[D_AXIS]) - sqrtk1[D_AXIS])),
+      LROUND(line_length_to_steps(A_AXIS, a)),
+      LROUND(line_length_to_steps(B_AXIS, b)),
+      LROUND(line_length_to_steps(C_AXIS, c)),
+      LROUND(line_length_to_steps(D_AXIS, d)),
     #else
       LROUND(a * axis_steps_per_mm[A_AXIS]),
       LROUND(b * axis_steps_per_mm[B_AXIS]),
@@ -2657,11 +3020,15 @@ void Planner::_set_position_mm(const float &a, const float &b, const float &c
   #if ENABLED(DISTINCT_E_FACTORS)
     last_extruder = active_extruder;
   #endif
+  #if ENABLED(CARTESIAN_JUNCTIONS)
+    // The Cartesian position is unknown, unless set_position_mm_kinematic sets it
+    position_cart_known = cartesian_move = cartesian_dir_known = previous_cartesian_dir_known = false;
+  #endif
   #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
-    position[A_AXIS] = LROUND(k0[A_AXIS] * (SQRT(k1[A_AXIS] + a * k2[A_AXIS]) - sqrtk1[A_AXIS])),
-    position[B_AXIS] = LROUND(k0[B_AXIS] * (SQRT(k1[B_AXIS] + b * k2[B_AXIS]) - sqrtk1[B_AXIS])),
-    position[C_AXIS] = LROUND(k0[C_AXIS] * (SQRT(k1[C_AXIS] + c * k2[C_AXIS]) - sqrtk1[C_AXIS])),
-    position[D_AXIS] = LROUND(k0[D_AXIS] * (SQRT(k1[D_AXIS] + d * k2[D_AXIS]) - sqrtk1[D_AXIS])),
+    position[A_AXIS] = LROUND(line_length_to_steps(A_AXIS, a)),
+    position[B_AXIS] = LROUND(line_length_to_steps(B_AXIS, b)),
+    position[C_AXIS] = LROUND(line_length_to_steps(C_AXIS, c)),
+    position[D_AXIS] = LROUND(line_length_to_steps(D_AXIS, d)),
   #else
     position[A_AXIS] = LROUND(a * axis_steps_per_mm[A_AXIS]);
     position[B_AXIS] = LROUND(b * axis_steps_per_mm[B_AXIS]);
@@ -2715,6 +3082,10 @@ void Planner::set_position_mm_kinematic(const float (&cart)[XYZE]) {
     #else
       _set_position_mm(delta[A_AXIS], delta[B_AXIS], delta[C_AXIS], cart[E_CART]);
     #endif
+    #if ENABLED(CARTESIAN_JUNCTIONS)
+      COPY(position_cart, cart);
+      position_cart_known = true;
+    #endif
   #else
     _set_position_mm(raw[X_AXIS], raw[Y_AXIS], raw[Z_AXIS], cart[E_CART]);
   #endif
@@ -2739,12 +3110,44 @@ void Planner::set_position_mm(const AxisEnum axis, const float &v) {
   #if HAS_POSITION_FLOAT
     position_float[axis] = v;
   #endif
+  #if ENABLED(CARTESIAN_JUNCTIONS)
+    // E is the same in both spaces. Any other axis leaves the Cartesian path.
+    if (axis == E_AXIS)
+      position_cart[E_CART] = v;
+    else
+      position_cart_known = previous_cartesian_dir_known = false;
+  #endif
   if (has_blocks_queued())
     buffer_sync_block();
   else
     stepper.set_position(axis, position[axis]);
 }
 
+#if ENABLED(CARTESIAN_JUNCTIONS)
+
+  /**
+   * Set the Cartesian direction of the next kinematic segment, from
+   * the end of the last one, and remember where this one ends.
+   * Called by the kinematic segmenters before buffer_segment.
+   */
+  void Planner::set_cartesian_direction(const float (&cart)[XYZE]) {
+    float length_sq = 0;
+    LOOP_XYZE(i) {
+      cartesian_unit_vec[i] = cart[i] - position_cart[i];
+      length_sq += sq(cartesian_unit_vec[i]);
+    }
+    cartesian_move = true;
+    cartesian_dir_known = position_cart_known && length_sq > 0;
+    if (cartesian_dir_known) {
+      const float inv_length = RSQRT(length_sq);
+      LOOP_XYZE(i) cartesian_unit_vec[i] *= inv_length;
+    }
+    COPY(position_cart, cart);
+    position_cart_known = true;
+  }
+
+#endif
+
 // Recalculate the steps/s^2 acceleration rates, based on the mm/s^2
 void Planner::reset_acceleration_rates() {
   #if ENABLED(DISTINCT_E_FACTORS)
@@ -2763,6 +3166,34 @@ void Planner::reset_acceleration_rates() {
   #endif
 }
 
+#if ENABLED(LINE_BUILDUP_TABLE)
+
+  /**
+   * Tabulate line_length_to_steps() from zero to max_length for each axis
+   * and find the largest interpolation error. Call whenever k0, k1, k2 or
+   * sqrtk1 change.
+   *
+   * k2 * L / (sqrt(k1 + k2 * L) + sqrtk1) equals sqrt(k1 + k2 * L) - sqrtk1
+   * without subtracting two nearly equal roots, so the table and the error
+   * are not limited by float rounding of the roots.
+   */
+  void Planner::refresh_buildup_table(const float (&max_length)[MOV_AXIS]) {
+    #define BUILDUP_STEPS(L) (k0[i] * k2[i] * (L) / (SQRT(k1[i] + k2[i] * (L)) + sqrtk1[i]))
+    buildup_table_error = 0;
+    LOOP_MOV_AXIS(i) {
+      const float spacing = max_length[i] * (1.0f / (LINE_BUILDUP_TABLE_SIZE));
+      buildup_table_scale[i] = 1.0f / spacing;
+      for (uint16_t j = 0; j <= LINE_BUILDUP_TABLE_SIZE; j++)
+        buildup_table[i][j] = BUILDUP_STEPS(j * spacing);
+      // The curvature has one sign, so the error peaks mid-interval
+      for (uint16_t j = 0; j < LINE_BUILDUP_TABLE_SIZE; j++)
+        NOLESS(buildup_table_error, ABS(BUILDUP_STEPS((j + 0.5f) * spacing) - 0.5f * (buildup_table[i][j] + buildup_table[i][j + 1])));
+    }
+    #undef BUILDUP_STEPS
+  }
+
+#endif // LINE_BUILDUP_TABLE
+
 // Recalculate position, steps_to_mm if axis_steps_per_mm changes!
 void Planner::refresh_positioning() {
   LOOP_NUM_AXIS_N(i) steps_to_mm[i] = 1.0f / axis_steps_per_mm[i];
@@ -54,6 +54,16 @@ enum BlockFlagBit : char {
 
   // Sync the stepper counts from the block
   BLOCK_BIT_SYNC_POSITION
+
+  #if ENABLED(STEP_RATE_TABLE)
+    // The rate table matches the trapezoid
+    , BLOCK_BIT_RATE_TABLE
+  #endif
+
+  #if ENABLED(PREPARED_BLOCKS)
+    // The Stepper ISR setup matches the trapezoid
+    , BLOCK_BIT_PREPARED
+  #endif
 };
 
 enum BlockFlag : char {
@@ -61,8 +71,28 @@ enum BlockFlag : char {
   BLOCK_FLAG_NOMINAL_LENGTH       = _BV(BLOCK_BIT_NOMINAL_LENGTH),
   BLOCK_FLAG_CONTINUED            = _BV(BLOCK_BIT_CONTINUED),
   BLOCK_FLAG_SYNC_POSITION        = _BV(BLOCK_BIT_SYNC_POSITION)
+  #if ENABLED(STEP_RATE_TABLE)
+    , BLOCK_FLAG_RATE_TABLE       = _BV(BLOCK_BIT_RATE_TABLE)
+  #endif
+  #if ENABLED(PREPARED_BLOCKS)
+    , BLOCK_FLAG_PREPARED         = _BV(BLOCK_BIT_PREPARED)
+  #endif
 };
 
+#if ENABLED(STEP_RATE_TABLE)
+  /**
+   * One segment of a block's tabulated acceleration or deceleration.
+   * The Stepper ISR adds 'delta' to the interval on every ISR until
+   * the 'until' step event is done, then moves on to the next segment.
+   */
+  typedef struct {
+    uint32_t until,                         // The step event that ends this segment
+             interval;                      // Timer ticks per ISR at the segment start (16.16 fixed point)
+    int32_t delta;                          // Change in the interval on each ISR (16.16 fixed point)
+    uint8_t loops;                          // Steps per ISR
+  } step_rate_segment_t;
+#endif
+
 /**
  * struct block_t
  *
@@ -118,6 +148,9 @@ typedef struct {
              deceleration_time_inverse;
   #else
     uint32_t acceleration_rate;             // The acceleration rate used for acceleration calculation
+    #if ENABLED(STEP_RATE_TABLE)
+      step_rate_segment_t rate_table[2 * (STEP_RATE_TABLE_SEGMENTS)]; // Acceleration, then deceleration segments
+    #endif
   #endif
 
   uint8_t direction_bits;                   // The direction bit set for this block (refers to *_DIRECTION_BIT in config.h)
@@ -146,9 +179,21 @@ typedef struct {
 
   uint32_t segment_time_us;
 
+  #if ENABLED(PREPARED_BLOCKS)
+    // Stepper ISR setup, filled in by Stepper::prepare_block
+    uint32_t initial_interval,              // Timer interval for the initial rate
+             nominal_interval;              // Timer interval for the nominal rate
+    uint8_t initial_loops,                  // Steps per ISR at the initial rate
+            nominal_loops,                  // Steps per ISR at the nominal rate
+            move_bits;                      // The axes that move, for endstop handling
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      uint8_t oversampling;                 // Step smoothing factor
+    #endif
+  #endif
+
 } block_t;
 
-#define HAS_POSITION_FLOAT (ENABLED(LIN_ADVANCE) || HAS_FEEDRATE_SCALING)
+#define HAS_POSITION_FLOAT (ENABLED(LIN_ADVANCE) || HAS_FEEDRATE_SCALING || ENABLED(MERGE_COLLINEAR_BLOCKS))
 
 #define BLOCK_MOD(n) ((n)&(BLOCK_BUFFER_SIZE-1))
 
@@ -173,6 +218,9 @@ class Planner {
                             block_buffer_nonbusy,   // Index of the first non busy block
                             block_buffer_planned,   // Index of the optimally planned block
                             block_buffer_tail;      // Index of the busy block, if any
+    #if ENABLED(DEEP_LOOKAHEAD)
+      static uint8_t block_buffer_replan;           // Index of the oldest block changed by the last reverse pass
+    #endif
     static uint16_t cleaning_buffer_counter;        // A counter to disable queuing of blocks
     static uint8_t delay_before_delivering;         // This counter delays delivery of blocks when queue becomes empty to allow the opportunity of merging blocks
 
@@ -217,6 +265,10 @@ class Planner {
       static float max_jerk[NUM_AXIS];          // (mm/s^2) M205 XYZE - The largest speed change requiring no acceleration.
     #endif
 
+    #if ENABLED(ARC_CURVE_PLANNING)
+      static float arc_radius;                  // (mm) Radius of the arc joining the next block to the last, 0 for a corner
+    #endif
+
     #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
       /*
        * Parameters for calculating target[]
@@ -227,6 +279,12 @@ class Planner {
                    k1[MOV_AXIS],
                    k2[MOV_AXIS],
                    sqrtk1[MOV_AXIS];
+
+      #if ENABLED(LINE_BUILDUP_TABLE)
+        static float buildup_table[MOV_AXIS][LINE_BUILDUP_TABLE_SIZE + 1], // Steps at evenly spaced line lengths
+                     buildup_table_scale[MOV_AXIS],                        // Table intervals per mm
+                     buildup_table_error;                                  // Largest interpolation error, in steps
+      #endif
     #endif
 
     #if HAS_LEVELING
@@ -288,6 +346,28 @@ class Planner {
      */
     static float previous_nominal_speed_sqr;
 
+    #if ENABLED(CARTESIAN_JUNCTIONS)
+      /**
+       * Cartesian path of kinematic segments, for their junctions
+       */
+      static float position_cart[XYZE],                 // Cartesian end of the last kinematic segment
+                   cartesian_unit_vec[XYZE],            // Cartesian direction of the segment being added
+                   previous_cartesian_unit_vec[XYZE];   // Cartesian direction of the previous segment
+      static bool position_cart_known,                  // No joint-space move since position_cart was set
+                  cartesian_move,                       // The segment being added comes from buffer_line_kinematic
+                  cartesian_dir_known,                  // ...and its Cartesian direction is known
+                  previous_cartesian_dir_known;
+    #endif
+
+    #if ENABLED(MERGE_COLLINEAR_BLOCKS)
+      /**
+       * The newest queued block, for merging the next segment into it
+       */
+      static float merge_start[NUM_AXIS],               // Start of the block, in planner units
+                   merge_deviation,                     // Deviation of the merged path from the block, so far
+                   merge_fr_mm_s;                       // Feedrate requested for the block
+    #endif
+
     /**
      * Limit where 64bit math is necessary for acceleration calculation
      */
@@ -301,7 +381,11 @@ class Planner {
       /**
        * Counters to manage disabling inactive extruders
        */
-      static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      #if BLOCK_BUFFER_SIZE >= 128
+        static uint16_t g_uc_extruder_last_move[EXTRUDERS];
+      #else
+        static uint8_t g_uc_extruder_last_move[EXTRUDERS];
+      #endif
     #endif // DISABLE_INACTIVE_EXTRUDER
 
     #ifdef XY_FREQUENCY_LIMIT
@@ -342,6 +426,27 @@ class Planner {
       );
     }
 
+    #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
+
+      #if ENABLED(LINE_BUILDUP_TABLE)
+        static void refresh_buildup_table(const float (&max_length)[MOV_AXIS]);
+      #endif
+
+      // Absolute steps for a line length, with the spool buildup taken into account
+      FORCE_INLINE static float line_length_to_steps(const AxisEnum axis, const float &length) {
+        #if ENABLED(LINE_BUILDUP_TABLE)
+          const float t = length * buildup_table_scale[axis];
+          if (t >= 0 && t < LINE_BUILDUP_TABLE_SIZE) {
+            const uint8_t i = t;
+            const float lo = buildup_table[axis][i];
+            return lo + (t - i) * (buildup_table[axis][i + 1] - lo);
+          }
+        #endif
+        return k0[axis] * (SQRT(k1[axis] + length * k2[axis]) - sqrtk1[axis]);
+      }
+
+    #endif
+
     // Manage fans, paste pressure, etc.
     static void check_axes_activity();
 
@@ -624,6 +729,9 @@ class Planner {
       #endif
       #if IS_KINEMATIC
         inverse_kinematics(raw);
+        #if ENABLED(CARTESIAN_JUNCTIONS)
+          set_cartesian_direction(cart);
+        #endif
         return buffer_segment(
           #if ENABLED(HANGPRINTER)
             line_lengths[A_AXIS], line_lengths[B_AXIS], line_lengths[C_AXIS], line_lengths[D_AXIS]
@@ -664,6 +772,11 @@ class Planner {
     }
     static void set_position_mm_kinematic(const float (&cart)[XYZE]);
     static void set_position_mm(const AxisEnum axis, const float &v);
+
+    #if ENABLED(CARTESIAN_JUNCTIONS)
+      // Set the Cartesian direction of the next kinematic segment
+      static void set_cartesian_direction(const float (&cart)[XYZE]);
+    #endif
     FORCE_INLINE static void set_z_position_mm(const float &z) { set_position_mm(Z_AXIS, z); }
     FORCE_INLINE static void set_e_position_mm(const float &e) { set_position_mm(E_AXIS, e); }
 
@@ -673,6 +786,16 @@ class Planner {
      */
     static float get_axis_position_mm(const AxisEnum axis);
 
+    /**
+     * Get an axis position for a number of steps, as get_axis_position_mm() does
+     */
+    FORCE_INLINE static float axis_steps_to_mm(const AxisEnum axis, const float axis_steps) {
+      #if ENABLED(LINE_BUILDUP_COMPENSATION_FEATURE)
+        if (axis != E_AXIS) return (sq(axis_steps / k0[axis] + sqrtk1[axis]) - k1[axis]) / k2[axis];
+      #endif
+      return axis_steps * steps_to_mm[axis];
+    }
+
     // SCARA AB axes are in degrees, not mm
     #if IS_SCARA
       FORCE_INLINE static float get_axis_position_degrees(const AxisEnum axis) { return get_axis_position_mm(axis); }
@@ -878,10 +1001,26 @@ class Planner {
     static void reverse_pass();
     static void forward_pass();
 
+    #if ENABLED(DEEP_LOOKAHEAD)
+      static uint8_t replan_start(const uint8_t first, const uint8_t head);
+    #endif
+
     static void recalculate_trapezoids();
 
+    #if ENABLED(STEP_RATE_TABLE)
+      static void tabulate_planned_blocks();
+    #endif
+
+    #if ENABLED(PREPARED_BLOCKS)
+      static void prepare_planned_blocks();
+    #endif
+
     static void recalculate();
 
+    #if ENABLED(MERGE_COLLINEAR_BLOCKS)
+      static bool merge_into_previous(const block_t * const block, const float (&segment_start)[NUM_AXIS], const float &fr_mm_s);
+    #endif
+
     #if ENABLED(JUNCTION_DEVIATION)
 
       FORCE_INLINE static void normalize_junction_vector(float (&vector)[XYZE]) {
@@ -31,6 +31,7 @@
 #include "power_loss_recovery.h"
 
 #include "cardreader.h"
+#include "parser.h"
 #include "planner.h"
 #include "printcounter.h"
 #include "serial.h"
@@ -88,12 +89,24 @@ extern uint8_t active_extruder, commands_in_queue, cmd_queue_index_r;
           SERIAL_PROTOCOLPAIR("leveling: ", int(job_recovery_info.leveling));
           SERIAL_PROTOCOLLNPAIR(" fade: ", int(job_recovery_info.fade));
         #endif
-        SERIAL_PROTOCOLLNPAIR("cmd_queue_index_r: ", int(job_recovery_info.cmd_queue_index_r));
-        SERIAL_PROTOCOLLNPAIR("commands_in_queue: ", int(job_recovery_info.commands_in_queue));
+        #if DISABLED(COMMAND_ARENA)
+          SERIAL_PROTOCOLLNPAIR("cmd_queue_index_r: ", int(job_recovery_info.cmd_queue_index_r));
+          SERIAL_PROTOCOLLNPAIR("commands_in_queue: ", int(job_recovery_info.commands_in_queue));
+        #endif
         if (recovery)
           for (uint8_t i = 0; i < job_recovery_commands_count; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_commands[i]);
-        else
-          for (uint8_t i = 0; i < job_recovery_info.commands_in_queue; i++) SERIAL_PROTOCOLLNPAIR("> ", job_recovery_info.command_queue[i]);
+        #if DISABLED(COMMAND_ARENA)
+          else
+            for (uint8_t i = 0; i < job_recovery_info.commands_in_queue; i++) {
+              #if HAS_PACKED_COMMANDS
+                char text[MAX_CMD_SIZE];
+                parser.unpack(text, job_recovery_info.command_queue[i], sizeof(text));
+                SERIAL_PROTOCOLLNPAIR("> ", text);
+              #else
+                SERIAL_PROTOCOLLNPAIR("> ", job_recovery_info.command_queue[i]);
+              #endif
+            }
+        #endif
         SERIAL_PROTOCOLLNPAIR("sd_filename: ", job_recovery_info.sd_filename);
         SERIAL_PROTOCOLLNPAIR("sdpos: ", job_recovery_info.sdpos);
         SERIAL_PROTOCOLLNPAIR("print_job_elapsed: ", job_recovery_info.print_job_elapsed);
@@ -167,11 +180,18 @@ void check_print_job_recovery() {
         );
         sprintf_P(job_recovery_commands[ind++], PSTR("G92.0 Z%s E%s"), str_1, str_2); // Current Z + 2 and E
 
-        uint8_t r = job_recovery_info.cmd_queue_index_r, c = job_recovery_info.commands_in_queue;
-        while (c--) {
-          strcpy(job_recovery_commands[ind++], job_recovery_info.command_queue[r]);
-          r = (r + 1) % BUFSIZE;
-        }
+        #if DISABLED(COMMAND_ARENA) // Otherwise the queued commands are read from SD again
+          uint8_t r = job_recovery_info.cmd_queue_index_r, c = job_recovery_info.commands_in_queue;
+          while (c--) {
+            // Packed commands are queued again as text
+            #if HAS_PACKED_COMMANDS
+              parser.unpack(job_recovery_commands[ind++], job_recovery_info.command_queue[r], MAX_CMD_SIZE);
+            #else
+              strcpy(job_recovery_commands[ind++], job_recovery_info.command_queue[r]);
+            #endif
+            r = (r + 1) % BUFSIZE;
+          }
+        #endif
 
         if (job_recovery_info.sd_filename[0] == '/') job_recovery_info.sd_filename[0] = ' ';
         sprintf_P(job_recovery_commands[ind++], PSTR("M23 %s"), job_recovery_info.sd_filename);
@@ -254,10 +274,12 @@ void save_job_recovery_info() {
       );
     #endif
 
-    // Commands in the queue
-    job_recovery_info.cmd_queue_index_r = cmd_queue_index_r;
-    job_recovery_info.commands_in_queue = commands_in_queue;
-    COPY(job_recovery_info.command_queue, command_queue);
+    #if DISABLED(COMMAND_ARENA)
+      // Commands in the queue
+      job_recovery_info.cmd_queue_index_r = cmd_queue_index_r;
+      job_recovery_info.commands_in_queue = commands_in_queue;
+      COPY(job_recovery_info.command_queue, command_queue);
+    #endif
 
     // Elapsed print job time
     job_recovery_info.print_job_elapsed = print_job_timer.duration();
@@ -265,6 +287,11 @@ void save_job_recovery_info() {
     // SD file position
     card.getAbsFilename(job_recovery_info.sd_filename);
     job_recovery_info.sdpos = card.getIndex();
+    #if ENABLED(COMMAND_ARENA)
+      // Resume from the oldest queued command read from SD
+      for (uint8_t i = 0, r = cmd_queue_index_r; i < commands_in_queue; i++, r = (r + 1) % (COMMAND_SLOTS))
+        if (command_sdpos[r]) { job_recovery_info.sdpos = command_sdpos[r] - 1; break; }
+    #endif
 
     #if ENABLED(DEBUG_POWER_LOSS_RECOVERY)
       SERIAL_PROTOCOLLNPGM("Saving...");
@@ -60,9 +60,11 @@ typedef struct {
     float fade;
   #endif
 
-  // Command queue
-  uint8_t cmd_queue_index_r, commands_in_queue;
-  char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  // Command queue. With COMMAND_ARENA, sdpos is that of the oldest queued SD command instead.
+  #if DISABLED(COMMAND_ARENA)
+    uint8_t cmd_queue_index_r, commands_in_queue;
+    char command_queue[BUFSIZE][MAX_CMD_SIZE];
+  #endif
 
   // SD Filename and position
   char sd_filename[MAXPATHNAMELENGTH];
@@ -0,0 +1,126 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * profiler.cpp - Time spent in the hot paths of the firmware
+ */
+
+#include "MarlinConfig.h"
+
+#if ENABLED(PROFILE_HOT_PATHS)
+
+#include "profiler.h"
+#include "Marlin.h"
+
+Profiler profiler;
+
+profile_stat_t Profiler::stats[PROFILE_SECTIONS];
+uint32_t Profiler::interrupt_us, // = 0
+         Profiler::window_start_us;
+uint8_t Profiler::auto_report_interval;
+millis_t Profiler::next_report_ms;
+
+static const char stepper_isr_name[] PROGMEM = "Stepper ISR",
+                  temperature_isr_name[] PROGMEM = "Temperature ISR",
+                  block_phase_name[] PROGMEM = "Block phase",
+                  buffer_segment_name[] PROGMEM = "buffer_segment",
+                  recalculate_name[] PROGMEM = "recalculate",
+                  process_command_name[] PROGMEM = "process_next_command",
+                  idle_name[] PROGMEM = "idle";
+
+static const char* const section_name[PROFILE_SECTIONS] PROGMEM = {
+  stepper_isr_name, temperature_isr_name, block_phase_name, buffer_segment_name,
+  recalculate_name, process_command_name, idle_name
+};
+
+void Profiler::end(const ProfileSection section, const uint32_t start_us, const uint32_t start_interrupt_us) {
+  // Leave out the interrupts that came in between. An interrupt
+  // adds its own time, so an interrupted one isn't counted twice.
+  CRITICAL_SECTION_START;
+  const uint32_t us = HAL_profile_us() - start_us - (interrupt_us - start_interrupt_us);
+  if (section < PROFILE_INTERRUPTS) interrupt_us += us;
+  CRITICAL_SECTION_END;
+
+  profile_stat_t &stat = stats[section];
+  if (!stat.count++ || us < stat.min) stat.min = us;
+  NOLESS(stat.max, us);
+  stat.total += us;
+
+  uint8_t bin = 0;
+  for (uint32_t limit = 4; bin < PROFILE_BINS - 1 && us >= limit; limit <<= 2) bin++;
+  if (stat.histogram[bin] < 0xFFFF) stat.histogram[bin]++;
+}
+
+/**
+ * Clear the statistics and start a new report window
+ */
+void Profiler::reset() {
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++) {
+    CRITICAL_SECTION_START;
+    memset(&stats[i], 0, sizeof(stats[i]));
+    CRITICAL_SECTION_END;
+  }
+  window_start_us = HAL_profile_us();
+}
+
+/**
+ * Report every section since the last report, then start over. For example:
+ *
+ *   echo:Profile of 1000ms: calls min/mean/max(us) share(%) histogram(<4us <16us <64us <256us <1ms <4ms <16ms more)
+ *   echo:Stepper ISR 2513 12/23/68 5.8% | 0 1912 597 4 0 0 0 0
+ */
+void Profiler::report() {
+  const uint32_t window_us = HAL_profile_us() - window_start_us;
+  SERIAL_ECHO_START();
+  SERIAL_ECHOPAIR("Profile of ", window_us / 1000);
+  SERIAL_ECHOLNPGM("ms: calls min/mean/max(us) share(%) histogram(<4us <16us <64us <256us <1ms <4ms <16ms more)");
+  for (uint8_t i = 0; i < PROFILE_SECTIONS; i++) {
+    profile_stat_t stat;
+    CRITICAL_SECTION_START;
+    stat = stats[i];
+    CRITICAL_SECTION_END;
+
+    SERIAL_ECHO_START();
+    serialprintPGM((const char*)pgm_read_ptr(&section_name[i]));
+    SERIAL_ECHOPAIR(" ", stat.count);
+    if (stat.count) {
+      SERIAL_ECHOPAIR(" ", stat.min);
+      SERIAL_ECHOPAIR("/", stat.total / stat.count);
+      SERIAL_ECHOPAIR("/", stat.max);
+      SERIAL_CHAR(' ');
+      SERIAL_ECHO_F(window_us ? 100.0f * stat.total / window_us : 0.0f, 1);
+      SERIAL_ECHOPGM("% |");
+      for (uint8_t b = 0; b < PROFILE_BINS; b++) SERIAL_ECHOPAIR(" ", stat.histogram[b]);
+    }
+    SERIAL_EOL();
+  }
+  reset();
+}
+
+void Profiler::auto_report() {
+  if (auto_report_interval && ELAPSED(millis(), next_report_ms)) {
+    next_report_ms = millis() + 1000UL * auto_report_interval;
+    report();
+  }
+}
+
+#endif // PROFILE_HOT_PATHS
@@ -0,0 +1,104 @@
+/**
+ * Marlin 3D Printer Firmware
+ * Copyright (C) 2016 MarlinFirmware [https://github.com/MarlinFirmware/Marlin]
+ *
+ * Based on Sprinter and grbl.
+ * Copyright (C) 2011 Camiel Gubbels / Erik van der Zalm
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/**
+ * profiler.h - Time spent in the hot paths of the firmware
+ *
+ * Each profiled section counts its calls and its min, mean and max time, with
+ * a histogram of the times. Interrupts are left out of the time of whatever
+ * they interrupt, so the shares of the interrupts and of the main loop add up.
+ * Main loop sections include the sections they call, e.g., process_next_command
+ * includes buffer_segment and any waiting in idle().
+ */
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+#include "MarlinConfig.h"
+
+enum ProfileSection : uint8_t {
+  // Interrupts
+  PROFILE_STEPPER_ISR,
+  PROFILE_TEMPERATURE_ISR,
+  // Called by an interrupt or the main loop
+  PROFILE_BLOCK_PHASE,
+  PROFILE_BUFFER_SEGMENT,
+  PROFILE_RECALCULATE,
+  PROFILE_PROCESS_COMMAND,
+  PROFILE_IDLE,
+  PROFILE_SECTIONS
+};
+
+#define PROFILE_INTERRUPTS  2   // The first sections are interrupts
+#define PROFILE_BINS        8   // Histogram bins: <4µs, <16µs, <64µs ... <16ms, longer
+
+typedef struct {
+  uint32_t count,                       // Calls
+           total, min, max;             // Times in µs
+  uint16_t histogram[PROFILE_BINS];     // Calls by time, saturated
+} profile_stat_t;
+
+class Profiler {
+  public:
+    static profile_stat_t stats[PROFILE_SECTIONS];
+    static uint32_t interrupt_us;       // Time spent in interrupts, not counting nested ones twice
+    static uint8_t auto_report_interval;
+
+    static void reset();
+    static void report();
+
+    static void auto_report();
+    FORCE_INLINE static void set_auto_report_interval(uint8_t v) {
+      NOMORE(v, 60);
+      auto_report_interval = v;
+      next_report_ms = millis() + 1000UL * v;
+    }
+
+    // Add the time of a section begun at 'start_us', when interrupts had taken 'start_interrupt_us'
+    static void end(const ProfileSection section, const uint32_t start_us, const uint32_t start_interrupt_us);
+
+  private:
+    static uint32_t window_start_us;
+    static millis_t next_report_ms;
+};
+
+extern Profiler profiler;
+
+/**
+ * Time a section from here to the end of the enclosing scope
+ */
+class ProfileScope {
+  public:
+    FORCE_INLINE ProfileScope(const ProfileSection s) : section(s) {
+      CRITICAL_SECTION_START;
+      start_us = HAL_profile_us();
+      start_interrupt_us = Profiler::interrupt_us;
+      CRITICAL_SECTION_END;
+    }
+    FORCE_INLINE ~ProfileScope() { Profiler::end(section, start_us, start_interrupt_us); }
+
+  private:
+    const ProfileSection section;
+    uint32_t start_us, start_interrupt_us;
+};
+
+#endif // _PROFILER_H_
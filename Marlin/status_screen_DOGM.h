@@ -196,6 +196,103 @@ inline void lcd_implementation_status_message(const bool blink) {
   #endif
 }
 
+static char xstring[5], ystring[5], zstring[7];
+#if ENABLED(FILAMENT_LCD_DISPLAY)
+  static char wstring[5], mstring[4];
+#endif
+
+static void lcd_implementation_status_strings() {
+  strcpy(xstring, ftostr4sign(LOGICAL_X_POSITION(current_position[X_AXIS])));
+  strcpy(ystring, ftostr4sign(LOGICAL_Y_POSITION(current_position[Y_AXIS])));
+  strcpy(zstring, ftostr52sp(LOGICAL_Z_POSITION(current_position[Z_AXIS])));
+  #if ENABLED(FILAMENT_LCD_DISPLAY)
+    strcpy(wstring, ftostr12ns(filament_width_meas));
+    strcpy(mstring, itostr3(100.0 * (
+        parser.volumetric_enabled
+          ? planner.volumetric_area_nominal / planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
+          : planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
+      )
+    ));
+  #endif
+}
+
+#if ENABLED(DOGM_STATUS_DIRTY_PAGES)
+
+  //
+  // Draw only the parts of the Info Screen that have changed.
+  //
+  // Each area of the screen keeps a checksum of the values it shows.
+  // When a checksum changes the rows of that area are marked dirty,
+  // one bit for every 8 rows. Pages without dirty rows aren't drawn.
+  //
+  static_assert(LCD_PIXEL_HEIGHT <= 64, "DOGM_STATUS_DIRTY_PAGES requires a display of no more than 64 rows.");
+
+  enum StatusArea : uint8_t {
+    STATUS_AREA_HEATERS,
+    STATUS_AREA_PROGRESS,
+    STATUS_AREA_XYZ,
+    STATUS_AREA_FEEDRATE,
+    STATUS_AREA_MESSAGE,
+    STATUS_AREAS
+  };
+
+  static uint16_t status_area_sum[STATUS_AREAS], status_sum;
+  static uint8_t status_dirty_rows; // 8 rows per bit
+  static bool status_shown;         // The whole Info Screen is on the display
+
+  static void status_sum_add(const int32_t v) {
+    for (uint8_t i = 0; i < 4; i++) status_sum = status_sum * 31 + uint8_t(v >> (i * 8));
+  }
+
+  static void status_sum_add(const char *str) {
+    while (const char c = *str++) status_sum = status_sum * 31 + c;
+  }
+
+  // Mark rows ya to yb dirty if the area has changed, and start the next area
+  static void status_area_done(const StatusArea area, const uint8_t ya, const uint8_t yb) {
+    if (!status_shown || status_sum != status_area_sum[area]) {
+      status_area_sum[area] = status_sum;
+      status_dirty_rows |= (0xFF << (ya >> 3)) & (0xFF >> (7 - (yb >> 3)));
+    }
+    status_sum = 0;
+  }
+
+  // Does the current page need drawing? Without page skipping
+  // in the display device every page is sent, so draw them all.
+  FORCE_INLINE bool status_page_dirty() {
+    #if ENABLED(DOGM_SKIP_CLEAN_PAGES)
+      const u8g_box_t &box = u8g.getU8g()->current_page;
+      return status_dirty_rows & (0xFF << (box.y0 >> 3)) & (0xFF >> (7 - (box.y1 >> 3)));
+    #else
+      return status_dirty_rows;
+    #endif
+  }
+
+  static void status_sum_heater(const int8_t heater, const bool blink) {
+    #if !HEATER_IDLE_HANDLER
+      UNUSED(blink);
+    #endif
+    #if HAS_HEATED_BED
+      if (heater < 0) {
+        status_sum_add(int16_t(0.5f + thermalManager.degTargetBed()));
+        status_sum_add(int16_t(0.5f + thermalManager.degBed()));
+        status_sum_add(thermalManager.isHeatingBed());
+        #if HEATER_IDLE_HANDLER
+          status_sum_add(blink || !thermalManager.is_bed_idle());
+        #endif
+        return;
+      }
+    #endif
+    status_sum_add(int16_t(0.5f + thermalManager.degTargetHotend(heater)));
+    status_sum_add(int16_t(0.5f + thermalManager.degHotend(heater)));
+    status_sum_add(thermalManager.isHeatingHotend(heater));
+    #if HEATER_IDLE_HANDLER
+      status_sum_add(blink || !thermalManager.is_heater_idle(heater));
+    #endif
+  }
+
+#endif // DOGM_STATUS_DIRTY_PAGES
+
 static void lcd_implementation_status_screen() {
 
   const bool blink = lcd_blink();
@@ -209,6 +306,15 @@ static void lcd_implementation_status_screen() {
     }
   #endif
 
+  #if ENABLED(DOGM_STATUS_DIRTY_PAGES)
+    if (!status_page_dirty()) {
+      #if ENABLED(DOGM_SKIP_CLEAN_PAGES)
+        u8g_dev_rrd_st7920_skip_page = true; // Leave this page on the display as it is
+      #endif
+      return;
+    }
+  #endif
+
   // Status Menu Font
   lcd_setFont(FONT_STATUSMENU);
 
@@ -375,26 +481,10 @@ static void lcd_implementation_status_screen() {
     #define XYZ_FRAME_HEIGHT INFO_FONT_HEIGHT + 1
   #endif
 
-  static char xstring[5], ystring[5], zstring[7];
-  #if ENABLED(FILAMENT_LCD_DISPLAY)
-    static char wstring[5], mstring[4];
-  #endif
-
   // At the first page, regenerate the XYZ strings
-  if (page.page == 0) {
-    strcpy(xstring, ftostr4sign(LOGICAL_X_POSITION(current_position[X_AXIS])));
-    strcpy(ystring, ftostr4sign(LOGICAL_Y_POSITION(current_position[Y_AXIS])));
-    strcpy(zstring, ftostr52sp(LOGICAL_Z_POSITION(current_position[Z_AXIS])));
-    #if ENABLED(FILAMENT_LCD_DISPLAY)
-      strcpy(wstring, ftostr12ns(filament_width_meas));
-      strcpy(mstring, itostr3(100.0 * (
-          parser.volumetric_enabled
-            ? planner.volumetric_area_nominal / planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-            : planner.volumetric_multiplier[FILAMENT_SENSOR_EXTRUDER_NUM]
-        )
-      ));
-    #endif
-  }
+  #if DISABLED(DOGM_STATUS_DIRTY_PAGES)
+    if (page.page == 0) lcd_implementation_status_strings();
+  #endif
 
   if (PAGE_CONTAINS(XYZ_FRAME_TOP, XYZ_FRAME_TOP + XYZ_FRAME_HEIGHT - 1)) {
 
@@ -490,4 +580,89 @@ static void lcd_implementation_status_screen() {
   }
 }
 
+#if ENABLED(DOGM_STATUS_DIRTY_PAGES)
+
+  /**
+   * Find the rows of the Info Screen that have changed since it was last drawn.
+   * Called before each screen is drawn. Return false if there's nothing to draw.
+   */
+  static bool lcd_implementation_status_changed(const bool in_status) {
+    if (!in_status) {
+      status_shown = false;
+      return true;
+    }
+
+    // Draw everything now and then, in case a checksum missed a change
+    static uint8_t frames;
+    if (++frames >= 16) {
+      frames = 0;
+      status_shown = false;
+    }
+
+    const bool blink = lcd_blink();
+    lcd_implementation_status_strings();
+    status_dirty_rows = 0;
+
+    // Heaters and fan
+    HOTEND_LOOP() status_sum_heater(e, blink);
+    #if HOTENDS < 4 && HAS_HEATED_BED
+      status_sum_heater(-1, blink);
+    #endif
+    #if HAS_FAN0
+      status_sum_add(fanSpeeds[0]);
+      if (fanSpeeds[0]) status_sum_add(blink);
+    #endif
+    status_area_done(STATUS_AREA_HEATERS, 0, 28);
+
+    // SD card, progress and elapsed time
+    #if ENABLED(SDSUPPORT)
+      status_sum_add(card.isFileOpen());
+    #endif
+    #if ENABLED(SDSUPPORT) || ENABLED(LCD_SET_PROGRESS_MANUALLY)
+      #if DISABLED(LCD_SET_PROGRESS_MANUALLY)
+        const uint8_t progress_bar_percent = card.percentDone();
+      #endif
+      status_sum_add(progress_bar_percent);
+      status_sum_add(print_job_timer.duration() / 60);
+    #endif
+    status_area_done(STATUS_AREA_PROGRESS, 41 - (TALL_FONT_CORRECTION), 52);
+
+    // XYZ, blinking while not homed
+    status_sum_add(xstring);
+    status_sum_add(ystring);
+    status_sum_add(zstring);
+    status_sum_add(axis_homed);
+    status_sum_add(axis_known_position);
+    if ((axis_homed & axis_known_position & (_BV(X_AXIS) | _BV(Y_AXIS) | _BV(Z_AXIS))) != (_BV(X_AXIS) | _BV(Y_AXIS) | _BV(Z_AXIS)))
+      status_sum_add(blink);
+    status_area_done(STATUS_AREA_XYZ, XYZ_FRAME_TOP, XYZ_FRAME_TOP + XYZ_FRAME_HEIGHT - 1);
+
+    status_sum_add(feedrate_percentage);
+    #if ENABLED(FILAMENT_LCD_DISPLAY) && DISABLED(SDSUPPORT)
+      status_sum_add(wstring);
+      status_sum_add(mstring);
+    #endif
+    status_area_done(STATUS_AREA_FEEDRATE, 51 - INFO_FONT_HEIGHT, 49);
+
+    // Status line, maybe scrolling or alternating with the filament display
+    status_sum_add(lcd_status_message);
+    #if ENABLED(STATUS_MESSAGE_SCROLLING)
+      if (utf8_strlen(lcd_status_message) > LCD_WIDTH) {
+        status_sum_add(status_scroll_offset);
+        status_sum_add(blink);
+      }
+    #endif
+    #if ENABLED(FILAMENT_LCD_DISPLAY) && ENABLED(SDSUPPORT)
+      status_sum_add(PENDING(millis(), previous_lcd_status_ms + 5000UL));
+      status_sum_add(wstring);
+      status_sum_add(mstring);
+    #endif
+    status_area_done(STATUS_AREA_MESSAGE, STATUS_BASELINE - (INFO_FONT_HEIGHT - 1), STATUS_BASELINE);
+
+    status_shown = true;
+    return status_dirty_rows;
+  }
+
+#endif // DOGM_STATUS_DIRTY_PAGES
+
 #endif // _STATUS_SCREEN_DOGM_H_
@@ -92,6 +92,10 @@
   #include <SPI.h>
 #endif
 
+#if ENABLED(PROFILE_HOT_PATHS)
+  #include "profiler.h"
+#endif
+
 Stepper stepper; // Singleton
 
 // public:
@@ -184,6 +188,12 @@ int32_t Stepper::ticks_nominal = -1;
   uint32_t Stepper::acc_step_rate; // needed for deceleration start point
 #endif
 
+#if ENABLED(STEP_RATE_TABLE)
+  bool Stepper::use_rate_table = false;
+  const step_rate_segment_t *Stepper::rate_segment;
+  uint32_t Stepper::rate_interval;
+#endif
+
 volatile int32_t Stepper::endstops_trigsteps[XYZ],
                  Stepper::count_position[NUM_AXIS] = { 0 };
 int8_t Stepper::count_direction[NUM_AXIS] = {
@@ -290,6 +300,94 @@ int8_t Stepper::count_direction[NUM_AXIS] = {
   #define E_APPLY_STEP(v,Q) E_STEP_WRITE(active_extruder, v)
 #endif
 
+#if ENABLED(COALESCE_PORT_WRITES)
+
+  /**
+   * Port channels are the step and direction pins written together, one I/O
+   * port at a time. They're numbered like the axes, so direction bits and the
+   * stepping axes map straight to channels. E0 is the last channel when it's
+   * the only E stepper and this ISR steps it.
+   *
+   * Each port is written by its lowest channel, gathering the pin bits of all
+   * the channels on the port. The pin addresses are constants, so only the
+   * writes of the ports in use are compiled.
+   */
+  #if ENABLED(HANGPRINTER)
+    #define PORT_CH_0 A
+    #define PORT_CH_1 B
+    #define PORT_CH_2 C
+    #define PORT_CH_3 D
+    #define PORT_CH_4 E0
+  #else
+    #define PORT_CH_0 X
+    #define PORT_CH_1 Y
+    #define PORT_CH_2 Z
+    #define PORT_CH_3 E0
+    #define PORT_CH_4 X // Unused
+  #endif
+
+  #if DISABLED(LIN_ADVANCE) && DISABLED(MIXING_EXTRUDER)
+    #if EXTRUDERS == 1
+      #define E_PORT_CHANNEL
+      #define PORT_CHANNELS (E_AXIS + 1)
+    #else
+      #define E_PORT_APART // The E stepper is chosen at runtime
+    #endif
+  #endif
+  #ifndef PORT_CHANNELS
+    #define PORT_CHANNELS E_AXIS
+  #endif
+
+  #define INVERT_E0_STEP_PIN INVERT_E_STEP_PIN
+
+  #define __CH_PIN(L,T) L##_##T##_PIN
+  #define _CH_PIN(L,T) __CH_PIN(L,T)
+  #define CH_PIN(I,T) _CH_PIN(PORT_CH_##I,T)
+
+  #define __CH_INVERT_STEP(L) INVERT_##L##_STEP_PIN
+  #define __CH_INVERT_DIR(L) INVERT_##L##_DIR
+  #define _CH_INVERT(L,T) __CH_INVERT_##T(L)
+  #define CH_INVERT(I,T) _CH_INVERT(PORT_CH_##I,T)
+
+  // Channels with an inverted pin
+  #define CH_INVERTED(T) ((CH_INVERT(0,T) ? _BV(0) : 0) | (CH_INVERT(1,T) ? _BV(1) : 0) | (CH_INVERT(2,T) ? _BV(2) : 0) \
+                        | (CH_INVERT(3,T) ? _BV(3) : 0) | (CH_INVERT(4,T) ? _BV(4) : 0))
+
+  // Port bits of the channels in CH on the port of channel I
+  #define _CH_PORT_BIT(T,I,J,CH) ((J) < PORT_CHANNELS && SAME_PORT(CH_PIN(I,T), CH_PIN(J,T)) && TEST(CH, J) ? _BV(PIN_BIT(CH_PIN(J,T))) : 0)
+  #define CH_PORT_BITS(T,I,CH) (_CH_PORT_BIT(T,I,0,CH) | _CH_PORT_BIT(T,I,1,CH) | _CH_PORT_BIT(T,I,2,CH) \
+                              | _CH_PORT_BIT(T,I,3,CH) | _CH_PORT_BIT(T,I,4,CH))
+
+  // Write the pins of the channels in CH, high for the channels in HIGH, if I is the lowest channel on its port
+  #define _CH_PORT_WRITE(T,I,CH,HIGH) do{ \
+    if ((I) < PORT_CHANNELS && !CH_PORT_BITS(T,I,_BV(I) - 1)) { \
+      const uint8_t port_mask = CH_PORT_BITS(T,I,CH); \
+      if (port_mask) WRITE_PORT(CH_PIN(I,T), port_mask, CH_PORT_BITS(T,I,(CH) & (HIGH))); \
+    } \
+  }while(0)
+
+  #define CH_PORT_WRITE(T,CH,HIGH) do{ \
+    const uint8_t ch = CH, high = HIGH; \
+    _CH_PORT_WRITE(T,0,ch,high); _CH_PORT_WRITE(T,1,ch,high); _CH_PORT_WRITE(T,2,ch,high); \
+    _CH_PORT_WRITE(T,3,ch,high); _CH_PORT_WRITE(T,4,ch,high); \
+  }while(0)
+
+  // Start or stop the pulses of the stepping channels
+  #if ENABLED(E_PORT_APART)
+    #define _E_PORT_APART_STEP(CH,V) do{ if (TEST(CH, E_AXIS)) E_APPLY_STEP((V) != INVERT_E_STEP_PIN, 0); }while(0)
+  #else
+    #define _E_PORT_APART_STEP(CH,V) NOOP
+  #endif
+  #define STEP_PORTS_WRITE(CH,V) do{ \
+    CH_PORT_WRITE(STEP, CH, (V) ? ~CH_INVERTED(STEP) : CH_INVERTED(STEP)); \
+    _E_PORT_APART_STEP(CH,V); \
+  }while(0)
+
+  // Set the direction pins of all channels from the direction bits
+  #define DIR_PORTS_WRITE(BITS) CH_PORT_WRITE(DIR, 0xFF, ~((BITS) ^ CH_INVERTED(DIR)))
+
+#endif // COALESCE_PORT_WRITES
+
 // intRes = longIn1 * longIn2 >> 24
 // uses:
 // A[tmp] to store 0
@@ -301,53 +399,57 @@ int8_t Stepper::count_direction[NUM_AXIS] = {
 // D C B A is longIn2
 //
 static FORCE_INLINE uint16_t MultiU24X32toH16(uint32_t longIn1, uint32_t longIn2) {
-  register uint8_t tmp1;
-  register uint8_t tmp2;
-  register uint16_t intRes;
-  __asm__ __volatile__(
-    A("clr %[tmp1]")
-    A("mul %A[longIn1], %B[longIn2]")
-    A("mov %[tmp2], r1")
-    A("mul %B[longIn1], %C[longIn2]")
-    A("movw %A[intRes], r0")
-    A("mul %C[longIn1], %C[longIn2]")
-    A("add %B[intRes], r0")
-    A("mul %C[longIn1], %B[longIn2]")
-    A("add %A[intRes], r0")
-    A("adc %B[intRes], r1")
-    A("mul %A[longIn1], %C[longIn2]")
-    A("add %[tmp2], r0")
-    A("adc %A[intRes], r1")
-    A("adc %B[intRes], %[tmp1]")
-    A("mul %B[longIn1], %B[longIn2]")
-    A("add %[tmp2], r0")
-    A("adc %A[intRes], r1")
-    A("adc %B[intRes], %[tmp1]")
-    A("mul %C[longIn1], %A[longIn2]")
-    A("add %[tmp2], r0")
-    A("adc %A[intRes], r1")
-    A("adc %B[intRes], %[tmp1]")
-    A("mul %B[longIn1], %A[longIn2]")
-    A("add %[tmp2], r1")
-    A("adc %A[intRes], %[tmp1]")
-    A("adc %B[intRes], %[tmp1]")
-    A("lsr %[tmp2]")
-    A("adc %A[intRes], %[tmp1]")
-    A("adc %B[intRes], %[tmp1]")
-    A("mul %D[longIn2], %A[longIn1]")
-    A("add %A[intRes], r0")
-    A("adc %B[intRes], r1")
-    A("mul %D[longIn2], %B[longIn1]")
-    A("add %B[intRes], r0")
-    A("clr r1")
-      : [intRes] "=&r" (intRes),
-        [tmp1] "=&r" (tmp1),
-        [tmp2] "=&r" (tmp2)
-      : [longIn1] "d" (longIn1),
-        [longIn2] "d" (longIn2)
-      : "cc"
-  );
-  return intRes;
+  #ifdef __AVR__
+    register uint8_t tmp1;
+    register uint8_t tmp2;
+    register uint16_t intRes;
+    __asm__ __volatile__(
+      A("clr %[tmp1]")
+      A("mul %A[longIn1], %B[longIn2]")
+      A("mov %[tmp2], r1")
+      A("mul %B[longIn1], %C[longIn2]")
+      A("movw %A[intRes], r0")
+      A("mul %C[longIn1], %C[longIn2]")
+      A("add %B[intRes], r0")
+      A("mul %C[longIn1], %B[longIn2]")
+      A("add %A[intRes], r0")
+      A("adc %B[intRes], r1")
+      A("mul %A[longIn1], %C[longIn2]")
+      A("add %[tmp2], r0")
+      A("adc %A[intRes], r1")
+      A("adc %B[intRes], %[tmp1]")
+      A("mul %B[longIn1], %B[longIn2]")
+      A("add %[tmp2], r0")
+      A("adc %A[intRes], r1")
+      A("adc %B[intRes], %[tmp1]")
+      A("mul %C[longIn1], %A[longIn2]")
+      A("add %[tmp2], r0")
+      A("adc %A[intRes], r1")
+      A("adc %B[intRes], %[tmp1]")
+      A("mul %B[longIn1], %A[longIn2]")
+      A("add %[tmp2], r1")
+      A("adc %A[intRes], %[tmp1]")
+      A("adc %B[intRes], %[tmp1]")
+      A("lsr %[tmp2]")
+      A("adc %A[intRes], %[tmp1]")
+      A("adc %B[intRes], %[tmp1]")
+      A("mul %D[longIn2], %A[longIn1]")
+      A("add %A[intRes], r0")
+      A("adc %B[intRes], r1")
+      A("mul %D[longIn2], %B[longIn1]")
+      A("add %B[intRes], r0")
+      A("clr r1")
+        : [intRes] "=&r" (intRes),
+          [tmp1] "=&r" (tmp1),
+          [tmp2] "=&r" (tmp2)
+        : [longIn1] "d" (longIn1),
+          [longIn2] "d" (longIn2)
+        : "cc"
+    );
+    return intRes;
+  #else
+    return uint16_t(((uint64_t)longIn1 * longIn2 + 0x00800000) >> 24);
+  #endif
 }
 
 void Stepper::wake_up() {
@@ -364,15 +466,20 @@ void Stepper::wake_up() {
  */
 void Stepper::set_directions() {
 
-  #define SET_STEP_DIR(A) \
-    if (motor_direction(_AXIS(A))) { \
-      A##_APPLY_DIR(INVERT_## A##_DIR, false); \
-      count_direction[_AXIS(A)] = -1; \
-    } \
-    else { \
-      A##_APPLY_DIR(!INVERT_## A##_DIR, false); \
-      count_direction[_AXIS(A)] = 1; \
-    }
+  #if ENABLED(COALESCE_PORT_WRITES)
+    // The direction pins are written together below
+    #define SET_STEP_DIR(A) count_direction[_AXIS(A)] = motor_direction(_AXIS(A)) ? -1 : 1
+  #else
+    #define SET_STEP_DIR(A) \
+      if (motor_direction(_AXIS(A))) { \
+        A##_APPLY_DIR(INVERT_## A##_DIR, false); \
+        count_direction[_AXIS(A)] = -1; \
+      } \
+      else { \
+        A##_APPLY_DIR(!INVERT_## A##_DIR, false); \
+        count_direction[_AXIS(A)] = 1; \
+      }
+  #endif
 
   #if HAS_X_DIR
     SET_STEP_DIR(X); // A
@@ -397,6 +504,8 @@ void Stepper::set_directions() {
         MIXING_STEPPERS_LOOP(j) NORM_E_DIR(j);
         count_direction[E_AXIS] = 1;
       }
+    #elif ENABLED(E_PORT_CHANNEL)
+      SET_STEP_DIR(E);
     #else
       if (motor_direction(E_AXIS)) {
         REV_E_DIR(active_extruder);
@@ -409,6 +518,10 @@ void Stepper::set_directions() {
     #endif
   #endif // !LIN_ADVANCE
 
+  #if ENABLED(COALESCE_PORT_WRITES)
+    DIR_PORTS_WRITE(last_direction_bits);
+  #endif
+
   // A small delay may be needed after changing direction
   #if MINIMUM_STEPPER_DIR_DELAY > 0
     DELAY_NS(MINIMUM_STEPPER_DIR_DELAY);
@@ -650,6 +763,8 @@ void Stepper::set_directions() {
    *    Coefficient calculation takes 70 cycles. Bezier point evaluation takes 150 cycles.
    */
 
+  #ifdef __AVR__
+
   // For AVR we use assembly to maximize speed
   void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
 
@@ -1138,6 +1253,56 @@ void Stepper::set_directions() {
     return (r2 | (uint16_t(r3) << 8)) | (uint32_t(r4) << 16);
   }
 
+  #else // !__AVR__
+
+  // The reference sequence from above, in C, for other targets such as the host simulator
+  void Stepper::_calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av) {
+    A_negative = v1 < v0;
+    const int32_t dv = A_negative ? v0 - v1 : v1 - v0;
+    bezier_A = 6 * dv;
+    bezier_B = 15 * dv;
+    bezier_C = 10 * dv;
+    bezier_F = v0;
+    bezier_AV = av;
+  }
+
+  FORCE_INLINE int32_t Stepper::_eval_bezier_curve(const uint32_t curr_step) {
+
+    // If dealing with the first step, save expensive computing and return the initial speed
+    if (!curr_step)
+      return bezier_F;
+
+    #define UMUL16X16TO16HI(A,B) uint16_t((uint32_t(A) * (B)) >> 16)
+    #define UMUL16X24TO24HI(A,B) (int32_t((uint64_t(A) * uint32_t(B)) >> 16) & 0xFFFFFF)
+
+    const uint16_t t = uint16_t((uint64_t(bezier_AV) * curr_step) >> 8);
+    uint16_t f = t;
+    f = UMUL16X16TO16HI(f, t);
+    f = UMUL16X16TO16HI(f, t);
+    int32_t acc = bezier_F;
+    if (A_negative) {
+      acc -= UMUL16X24TO24HI(f, bezier_C);
+      f = UMUL16X16TO16HI(f, t);
+      acc += UMUL16X24TO24HI(f, bezier_B);
+      f = UMUL16X16TO16HI(f, t);
+      acc -= UMUL16X24TO24HI(f, bezier_A);
+    }
+    else {
+      acc += UMUL16X24TO24HI(f, bezier_C);
+      f = UMUL16X16TO16HI(f, t);
+      acc -= UMUL16X24TO24HI(f, bezier_B);
+      f = UMUL16X16TO16HI(f, t);
+      acc += UMUL16X24TO24HI(f, bezier_A);
+    }
+
+    #undef UMUL16X16TO16HI
+    #undef UMUL16X24TO24HI
+
+    return acc & 0xFFFFFF;
+  }
+
+  #endif // !__AVR__
+
 #endif // S_CURVE_ACCELERATION
 
 /**
@@ -1159,6 +1324,10 @@ HAL_STEP_TIMER_ISR {
 void Stepper::isr() {
   DISABLE_ISRS();
 
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_STEPPER_ISR);
+  #endif
+
   // Program timer compare for the maximum period, so it does NOT
   // flag an interrupt while this ISR is running - So changes from small
   // periods to big periods are respected and the timer does not reset to 0
@@ -1319,22 +1488,44 @@ void Stepper::stepper_pulse_phase_isr() {
     #define _APPLY_STEP(AXIS) AXIS ##_APPLY_STEP
     #define _INVERT_STEP_PIN(AXIS) INVERT_## AXIS ##_STEP_PIN
 
-    // Start an active pulse, if Bresenham says so, and update position
-    #define PULSE_START(AXIS) do{ \
-      delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
-      if (delta_error[_AXIS(AXIS)] >= 0) { \
-        _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS), 0); \
-        if (COUNT_IT) count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
-      } \
-    }while(0)
+    #if ENABLED(COALESCE_PORT_WRITES)
 
-    // Stop an active pulse, if any, and adjust error term
-    #define PULSE_STOP(AXIS) do { \
-      if (delta_error[_AXIS(AXIS)] >= 0) { \
-        delta_error[_AXIS(AXIS)] -= advance_divisor; \
-        _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS), 0); \
-      } \
-    }while(0)
+      // Mark the channel of an active pulse, if Bresenham says so, and update position
+      #define PULSE_START(AXIS) do{ \
+        delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
+        if (delta_error[_AXIS(AXIS)] >= 0) { \
+          SBI(pulse_channels, _AXIS(AXIS)); \
+          if (COUNT_IT) count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+        } \
+      }while(0)
+
+      // Adjust the error term of an active pulse, stopped with the others
+      #define PULSE_STOP(AXIS) do { \
+        if (delta_error[_AXIS(AXIS)] >= 0) delta_error[_AXIS(AXIS)] -= advance_divisor; \
+      }while(0)
+
+      uint8_t pulse_channels = 0;
+
+    #else
+
+      // Start an active pulse, if Bresenham says so, and update position
+      #define PULSE_START(AXIS) do{ \
+        delta_error[_AXIS(AXIS)] += advance_dividend[_AXIS(AXIS)]; \
+        if (delta_error[_AXIS(AXIS)] >= 0) { \
+          _APPLY_STEP(AXIS)(!_INVERT_STEP_PIN(AXIS), 0); \
+          if (COUNT_IT) count_position[_AXIS(AXIS)] += count_direction[_AXIS(AXIS)]; \
+        } \
+      }while(0)
+
+      // Stop an active pulse, if any, and adjust error term
+      #define PULSE_STOP(AXIS) do { \
+        if (delta_error[_AXIS(AXIS)] >= 0) { \
+          delta_error[_AXIS(AXIS)] -= advance_divisor; \
+          _APPLY_STEP(AXIS)(_INVERT_STEP_PIN(AXIS), 0); \
+        } \
+      }while(0)
+
+    #endif
 
     // Pulse start
     #if ENABLED(HANGPRINTER)
@@ -1396,6 +1587,10 @@ void Stepper::stepper_pulse_phase_isr() {
       #endif
     #endif // !LIN_ADVANCE
 
+    #if ENABLED(COALESCE_PORT_WRITES)
+      STEP_PORTS_WRITE(pulse_channels, HIGH);
+    #endif
+
     #if MINIMUM_STEPPER_PULSE
       // Just wait for the requested pulse duration
       while (HAL_timer_get_count(PULSE_TIMER_NUM) < pulse_end) { /* nada */ }
@@ -1404,6 +1599,10 @@ void Stepper::stepper_pulse_phase_isr() {
     // Add the delay needed to ensure the maximum driver rate is enforced
     if (signed(added_step_ticks) > 0) pulse_end += hal_timer_t(added_step_ticks);
 
+    #if ENABLED(COALESCE_PORT_WRITES)
+      STEP_PORTS_WRITE(pulse_channels, LOW);
+    #endif
+
     #if ENABLED(HANGPRINTER)
       #if HAS_A_STEP
         PULSE_STOP(A);
@@ -1462,8 +1661,105 @@ void Stepper::stepper_pulse_phase_isr() {
 // properly schedules blocks from the planner. This is executed after creating
 // the step pulses, so it is not time critical, as pulses are already done.
 
+/**
+ * The axes a block moves, for endstop handling
+ */
+FORCE_INLINE uint8_t Stepper::block_move_bits(const block_t * const block) {
+  #if IS_CORE
+    // Define conditions for checking endstops
+    #define S_(N) block->steps[CORE_AXIS_##N]
+    #define D_(N) TEST(block->direction_bits, CORE_AXIS_##N)
+  #endif
+
+  #if CORE_IS_XY || CORE_IS_XZ
+    /**
+     * Head direction in -X axis for CoreXY and CoreXZ bots.
+     *
+     * If steps differ, both axes are moving.
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z, handled below)
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X)
+     */
+    #if ENABLED(COREXY) || ENABLED(COREXZ)
+      #define X_CMP ==
+    #else
+      #define X_CMP !=
+    #endif
+    #define X_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) X_CMP D_(2)) )
+  #else
+    #define X_MOVE_TEST !!block->steps[A_AXIS]
+  #endif
+
+  #if CORE_IS_XY || CORE_IS_YZ
+    /**
+     * Head direction in -Y axis for CoreXY / CoreYZ bots.
+     *
+     * If steps differ, both axes are moving
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y)
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z)
+     */
+    #if ENABLED(COREYX) || ENABLED(COREYZ)
+      #define Y_CMP ==
+    #else
+      #define Y_CMP !=
+    #endif
+    #define Y_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Y_CMP D_(2)) )
+  #else
+    #define Y_MOVE_TEST !!block->steps[B_AXIS]
+  #endif
+
+  #if CORE_IS_XZ || CORE_IS_YZ
+    /**
+     * Head direction in -Z axis for CoreXZ or CoreYZ bots.
+     *
+     * If steps differ, both axes are moving
+     * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y, already handled above)
+     * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Z)
+     */
+    #if ENABLED(COREZX) || ENABLED(COREZY)
+      #define Z_CMP ==
+    #else
+      #define Z_CMP !=
+    #endif
+    #define Z_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Z_CMP D_(2)) )
+  #else
+    #define Z_MOVE_TEST !!block->steps[C_AXIS]
+  #endif
+
+  uint8_t axis_bits = 0;
+  if (X_MOVE_TEST) SBI(axis_bits, A_AXIS);
+  if (Y_MOVE_TEST) SBI(axis_bits, B_AXIS);
+  if (Z_MOVE_TEST) SBI(axis_bits, C_AXIS);
+  //if (!!block->steps[E_AXIS]) SBI(axis_bits, E_AXIS);
+  //if (!!block->steps[A_AXIS]) SBI(axis_bits, X_HEAD);
+  //if (!!block->steps[B_AXIS]) SBI(axis_bits, Y_HEAD);
+  //if (!!block->steps[C_AXIS]) SBI(axis_bits, Z_HEAD);
+  return axis_bits;
+}
+
+#if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+
+  /**
+   * Decide if a block can use Stepper movement axis smoothing
+   */
+  FORCE_INLINE uint8_t Stepper::block_oversampling(const block_t * const block) {
+    uint8_t oversampling = 0;
+    uint32_t max_rate = block->nominal_rate;  // Get the maximum rate (maximum event speed)
+    while (max_rate < MIN_STEP_ISR_FREQUENCY) {
+      max_rate <<= 1;
+      if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break;
+      ++oversampling;
+    }
+    return oversampling;
+  }
+
+#endif
+
 uint32_t Stepper::stepper_block_phase_isr() {
 
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_BLOCK_PHASE);
+  #endif
+
   // If no queued movements, just wait 1ms for the next move
   uint32_t interval = (STEPPER_TIMER_RATE / 1000);
 
@@ -1482,22 +1778,29 @@ uint32_t Stepper::stepper_block_phase_isr() {
       // Are we in acceleration phase ?
       if (step_events_completed <= accelerate_until) { // Calculate new timer value
 
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // Get the next speed to use (Jerk limited!)
-          uint32_t acc_step_rate =
-            acceleration_time < current_block->acceleration_time
-              ? _eval_bezier_curve(acceleration_time)
-              : current_block->cruise_rate;
-        #else
-          acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
-          NOMORE(acc_step_rate, current_block->nominal_rate);
+        #if ENABLED(STEP_RATE_TABLE)
+          if (use_rate_table)
+            interval = rate_table_interval();
+          else
         #endif
+        {
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // Get the next speed to use (Jerk limited!)
+            uint32_t acc_step_rate =
+              acceleration_time < current_block->acceleration_time
+                ? _eval_bezier_curve(acceleration_time)
+                : current_block->cruise_rate;
+          #else
+            acc_step_rate = STEP_MULTIPLY(acceleration_time, current_block->acceleration_rate) + current_block->initial_rate;
+            NOMORE(acc_step_rate, current_block->nominal_rate);
+          #endif
 
-        // acc_step_rate is in steps/second
+          // acc_step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
-        acceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(acc_step_rate, oversampling_factor, &steps_per_isr);
+          acceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1509,40 +1812,48 @@ uint32_t Stepper::stepper_block_phase_isr() {
       }
       // Are we in Deceleration phase ?
       else if (step_events_completed > decelerate_after) {
-        uint32_t step_rate;
-
-        #if ENABLED(S_CURVE_ACCELERATION)
-          // If this is the 1st time we process the 2nd half of the trapezoid...
-          if (!bezier_2nd_half) {
-            // Initialize the Bézier speed curve
-            _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
-            bezier_2nd_half = true;
-            // The first point starts at cruise rate. Just save evaluation of the Bézier curve
-            step_rate = current_block->cruise_rate;
-          }
-          else {
-            // Calculate the next speed to use
-            step_rate = deceleration_time < current_block->deceleration_time
-              ? _eval_bezier_curve(deceleration_time)
-              : current_block->final_rate;
-          }
-        #else
 
-          // Using the old trapezoidal control
-          step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
-          if (step_rate < acc_step_rate) { // Still decelerating?
-            step_rate = acc_step_rate - step_rate;
-            NOLESS(step_rate, current_block->final_rate);
-          }
+        #if ENABLED(STEP_RATE_TABLE)
+          if (use_rate_table)
+            interval = rate_table_interval();
           else
-            step_rate = current_block->final_rate;
         #endif
+        {
+          uint32_t step_rate;
+
+          #if ENABLED(S_CURVE_ACCELERATION)
+            // If this is the 1st time we process the 2nd half of the trapezoid...
+            if (!bezier_2nd_half) {
+              // Initialize the Bézier speed curve
+              _calc_bezier_curve_coeffs(current_block->cruise_rate, current_block->final_rate, current_block->deceleration_time_inverse);
+              bezier_2nd_half = true;
+              // The first point starts at cruise rate. Just save evaluation of the Bézier curve
+              step_rate = current_block->cruise_rate;
+            }
+            else {
+              // Calculate the next speed to use
+              step_rate = deceleration_time < current_block->deceleration_time
+                ? _eval_bezier_curve(deceleration_time)
+                : current_block->final_rate;
+            }
+          #else
 
-        // step_rate is in steps/second
+            // Using the old trapezoidal control
+            step_rate = STEP_MULTIPLY(deceleration_time, current_block->acceleration_rate);
+            if (step_rate < acc_step_rate) { // Still decelerating?
+              step_rate = acc_step_rate - step_rate;
+              NOLESS(step_rate, current_block->final_rate);
+            }
+            else
+              step_rate = current_block->final_rate;
+          #endif
+
+          // step_rate is in steps/second
 
-        // step_rate to timer interval and steps per stepper isr
-        interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
-        deceleration_time += interval;
+          // step_rate to timer interval and steps per stepper isr
+          interval = calc_timer_interval(step_rate, oversampling_factor, &steps_per_isr);
+          deceleration_time += interval;
+        }
 
         #if ENABLED(LIN_ADVANCE)
           if (LA_use_advance_lead) {
@@ -1565,8 +1876,17 @@ uint32_t Stepper::stepper_block_phase_isr() {
 
         // Calculate the ticks_nominal for this nominal speed, if not done yet
         if (ticks_nominal < 0) {
-          // step_rate to timer interval and loops for the nominal speed
-          ticks_nominal = calc_timer_interval(current_block->nominal_rate, oversampling_factor, &steps_per_isr);
+          #if ENABLED(PREPARED_BLOCKS)
+            if (TEST(current_block->flag, BLOCK_BIT_PREPARED)) {
+              ticks_nominal = current_block->nominal_interval;
+              steps_per_isr = current_block->nominal_loops;
+            }
+            else
+          #endif
+            {
+              // step_rate to timer interval and loops for the nominal speed
+              ticks_nominal = calc_timer_interval(current_block->nominal_rate, oversampling_factor, &steps_per_isr);
+            }
         }
 
         // The timer interval is just the nominal value for the nominal speed
@@ -1598,92 +1918,33 @@ uint32_t Stepper::stepper_block_phase_isr() {
           return interval; // No more queued movements!
       }
 
-      // Flag all moving axes for proper endstop handling
-
-      #if IS_CORE
-        // Define conditions for checking endstops
-        #define S_(N) current_block->steps[CORE_AXIS_##N]
-        #define D_(N) TEST(current_block->direction_bits, CORE_AXIS_##N)
+      #if ENABLED(PREPARED_BLOCKS)
+        // Use the setup the planner has prepared, if any
+        const bool prepared = TEST(current_block->flag, BLOCK_BIT_PREPARED);
       #endif
 
-      #if CORE_IS_XY || CORE_IS_XZ
-        /**
-         * Head direction in -X axis for CoreXY and CoreXZ bots.
-         *
-         * If steps differ, both axes are moving.
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z, handled below)
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X)
-         */
-        #if ENABLED(COREXY) || ENABLED(COREXZ)
-          #define X_CMP ==
-        #else
-          #define X_CMP !=
-        #endif
-        #define X_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) X_CMP D_(2)) )
-      #else
-        #define X_MOVE_TEST !!current_block->steps[A_AXIS]
-      #endif
-
-      #if CORE_IS_XY || CORE_IS_YZ
-        /**
-         * Head direction in -Y axis for CoreXY / CoreYZ bots.
-         *
-         * If steps differ, both axes are moving
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y)
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Y or Z)
-         */
-        #if ENABLED(COREYX) || ENABLED(COREYZ)
-          #define Y_CMP ==
-        #else
-          #define Y_CMP !=
-        #endif
-        #define Y_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Y_CMP D_(2)) )
-      #else
-        #define Y_MOVE_TEST !!current_block->steps[B_AXIS]
-      #endif
-
-      #if CORE_IS_XZ || CORE_IS_YZ
-        /**
-         * Head direction in -Z axis for CoreXZ or CoreYZ bots.
-         *
-         * If steps differ, both axes are moving
-         * If DeltaA ==  DeltaB, the movement is only in the 1st axis (X or Y, already handled above)
-         * If DeltaA == -DeltaB, the movement is only in the 2nd axis (Z)
-         */
-        #if ENABLED(COREZX) || ENABLED(COREZY)
-          #define Z_CMP ==
-        #else
-          #define Z_CMP !=
+      // Flag all moving axes for proper endstop handling
+      axis_did_move = (
+        #if ENABLED(PREPARED_BLOCKS)
+          prepared ? current_block->move_bits :
         #endif
-        #define Z_MOVE_TEST ( S_(1) != S_(2) || (S_(1) > 0 && D_(1) Z_CMP D_(2)) )
-      #else
-        #define Z_MOVE_TEST !!current_block->steps[C_AXIS]
-      #endif
-
-      uint8_t axis_bits = 0;
-      if (X_MOVE_TEST) SBI(axis_bits, A_AXIS);
-      if (Y_MOVE_TEST) SBI(axis_bits, B_AXIS);
-      if (Z_MOVE_TEST) SBI(axis_bits, C_AXIS);
-      //if (!!current_block->steps[E_AXIS]) SBI(axis_bits, E_AXIS);
-      //if (!!current_block->steps[A_AXIS]) SBI(axis_bits, X_HEAD);
-      //if (!!current_block->steps[B_AXIS]) SBI(axis_bits, Y_HEAD);
-      //if (!!current_block->steps[C_AXIS]) SBI(axis_bits, Z_HEAD);
-      axis_did_move = axis_bits;
+        block_move_bits(current_block)
+      );
 
       // No acceleration / deceleration time elapsed so far
       acceleration_time = deceleration_time = 0;
 
-      uint8_t oversampling = 0;                         // Assume we won't use it
-
       #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
         // At this point, we must decide if we can use Stepper movement axis smoothing.
-        uint32_t max_rate = current_block->nominal_rate;  // Get the maximum rate (maximum event speed)
-        while (max_rate < MIN_STEP_ISR_FREQUENCY) {
-          max_rate <<= 1;
-          if (max_rate >= MAX_STEP_ISR_FREQUENCY_1X) break;
-          ++oversampling;
-        }
+        const uint8_t oversampling = (
+          #if ENABLED(PREPARED_BLOCKS)
+            prepared ? current_block->oversampling :
+          #endif
+          block_oversampling(current_block)
+        );
         oversampling_factor = oversampling;
+      #else
+        constexpr uint8_t oversampling = 0;
       #endif
 
       // Based on the oversampling factor, do the calculations
@@ -1789,6 +2050,16 @@ uint32_t Stepper::stepper_block_phase_isr() {
         acc_step_rate = current_block->initial_rate;
       #endif
 
+      #if ENABLED(STEP_RATE_TABLE)
+        // Use the rate table if the planner filled it in time.
+        // The first interval is set below, so begin the table one ISR in.
+        use_rate_table = TEST(current_block->flag, BLOCK_BIT_RATE_TABLE);
+        if (use_rate_table) {
+          rate_segment = current_block->rate_table;
+          rate_interval = rate_segment->interval + rate_segment->delta;
+        }
+      #endif
+
       #if ENABLED(S_CURVE_ACCELERATION)
         // Initialize the Bézier speed curve
         _calc_bezier_curve_coeffs(current_block->initial_rate, current_block->cruise_rate, current_block->acceleration_time_inverse);
@@ -1797,7 +2068,14 @@ uint32_t Stepper::stepper_block_phase_isr() {
       #endif
 
       // Calculate the initial timer interval
-      interval = calc_timer_interval(current_block->initial_rate, oversampling_factor, &steps_per_isr);
+      #if ENABLED(PREPARED_BLOCKS)
+        if (prepared) {
+          interval = current_block->initial_interval;
+          steps_per_isr = current_block->initial_loops;
+        }
+        else
+      #endif
+          interval = calc_timer_interval(current_block->initial_rate, oversampling_factor, &steps_per_isr);
     }
   }
 
@@ -1922,6 +2200,110 @@ bool Stepper::is_block_busy(const block_t* const block) {
   return block == vnew;
 }
 
+#if ENABLED(STEP_RATE_TABLE)
+
+  /**
+   * Tabulate one ramp of a block, from rate0 at step event 'first' to
+   * rate1 at step event 'last'. The segments end where the step rate has
+   * changed by an equal ratio, and interpolate the ISR interval linearly
+   * between the intervals at their ends. The interval is a convex function
+   * of the step event, so the interpolation never runs faster than planned.
+   */
+  step_rate_segment_t* Stepper::tabulate_ramp(step_rate_segment_t *seg, const uint32_t first, const uint32_t last, const float &rate0, const float &rate1, const float &accel2) {
+
+    // An empty ramp holds its end rate, for the ISR that reaches it at the boundary
+    if (first == last) {
+      uint8_t loops;
+      const uint32_t interval = calc_timer_interval(rate1, 0, &loops) << 16;
+      for (uint8_t i = STEP_RATE_TABLE_SEGMENTS; i--; seg++) {
+        seg->until = last;
+        seg->interval = interval;
+        seg->delta = 0;
+        seg->loops = loops;
+      }
+      return seg;
+    }
+
+    const float ratio = POW(rate1 / rate0, 1.0f / (STEP_RATE_TABLE_SEGMENTS)),
+                inv_accel2 = 1.0f / accel2;
+    float rate = rate0;
+    uint32_t start = first;
+    uint8_t loops0, loops1;
+    uint32_t interval0 = calc_timer_interval(rate0, 0, &loops0);
+    for (uint8_t i = STEP_RATE_TABLE_SEGMENTS; i--; seg++) {
+      const float next_rate = i ? rate * ratio : rate1;
+      const uint32_t until = i ? constrain(first + LROUND((sq(next_rate) - sq(rate0)) * inv_accel2), start, last) : last;
+      const uint32_t interval1 = calc_timer_interval(next_rate, 0, &loops1);
+
+      // Keep the multistepping of the faster end for the whole segment
+      const uint8_t loops = MAX(loops0, loops1);
+      const uint32_t isr_interval0 = interval0 * (loops / loops0),
+                     isr_interval1 = interval1 * (loops / loops1),
+                     isrs = (until - start + loops - 1) / loops;
+
+      seg->until = until;
+      seg->interval = isr_interval0 << 16;
+      seg->delta = isrs ? LROUND((float(isr_interval1) - float(isr_interval0)) * 65536.0f / isrs) : 0;
+      seg->loops = loops;
+
+      start = until;
+      rate = next_rate;
+      interval0 = interval1;
+      loops0 = loops1;
+    }
+    return seg;
+  }
+
+  /**
+   * Fill the rate table of a block from its trapezoid, accelerating from
+   * the initial rate and decelerating from the rate reached to the final rate.
+   * Called by the planner once the block's trapezoid is final. The block
+   * is marked last, so the ISR only uses a complete table.
+   */
+  void Stepper::calculate_rate_table(block_t * const block) {
+    const float accel2 = 2.0f * block->acceleration_steps_per_s2,
+                peak_rate = MIN(SQRT(sq(float(block->initial_rate)) + accel2 * block->accelerate_until), float(block->nominal_rate));
+    step_rate_segment_t * const seg = tabulate_ramp(block->rate_table, 0, block->accelerate_until, block->initial_rate, peak_rate, accel2);
+    tabulate_ramp(seg, block->decelerate_after, block->step_event_count, peak_rate, block->final_rate, -accel2);
+    sw_barrier();
+    SBI(block->flag, BLOCK_BIT_RATE_TABLE);
+  }
+
+#endif // STEP_RATE_TABLE
+
+#if ENABLED(PREPARED_BLOCKS)
+
+  /**
+   * Work out what the ISR sets up at the start of a block, so it
+   * only has to copy it. Called by the planner once the block's
+   * trapezoid is final. The block is marked last, so the ISR only
+   * uses a complete setup.
+   *
+   * The rest of the block start stays in the ISR:
+   *  - Bresenham counters, direction bits and endstops.update() set the
+   *    state of the running block and the pins, so they can't be written
+   *    before the previous block ends. The counters are only shifted steps.
+   *  - LIN_ADVANCE values are already worked out by the planner. The ISR
+   *    only copies them, and resets the pressure on an extruder change,
+   *    which depends on the block that ran before.
+   *  - S-curve coefficients take a few adds and shifts, about what a copy
+   *    of 13 more bytes per block would cost.
+   */
+  void Stepper::prepare_block(block_t * const block) {
+    block->move_bits = block_move_bits(block);
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      const uint8_t oversampling = block->oversampling = block_oversampling(block);
+    #else
+      constexpr uint8_t oversampling = 0;
+    #endif
+    block->initial_interval = calc_timer_interval(block->initial_rate, oversampling, &block->initial_loops);
+    block->nominal_interval = calc_timer_interval(block->nominal_rate, oversampling, &block->nominal_loops);
+    sw_barrier();
+    SBI(block->flag, BLOCK_BIT_PREPARED);
+  }
+
+#endif // PREPARED_BLOCKS
+
 void Stepper::init() {
 
   // Init Digipot Motor Current
@@ -200,26 +200,30 @@
 // r26 to store 0
 // r27 to store the byte 1 of the 24 bit result
 static FORCE_INLINE uint16_t MultiU16X8toH16(uint8_t charIn1, uint16_t intIn2) {
-  register uint8_t tmp;
-  register uint16_t intRes;
-  __asm__ __volatile__ (
-    A("clr %[tmp]")
-    A("mul %[charIn1], %B[intIn2]")
-    A("movw %A[intRes], r0")
-    A("mul %[charIn1], %A[intIn2]")
-    A("add %A[intRes], r1")
-    A("adc %B[intRes], %[tmp]")
-    A("lsr r0")
-    A("adc %A[intRes], %[tmp]")
-    A("adc %B[intRes], %[tmp]")
-    A("clr r1")
-      : [intRes] "=&r" (intRes),
-        [tmp] "=&r" (tmp)
-      : [charIn1] "d" (charIn1),
-        [intIn2] "d" (intIn2)
-      : "cc"
-  );
-  return intRes;
+  #ifdef __AVR__
+    register uint8_t tmp;
+    register uint16_t intRes;
+    __asm__ __volatile__ (
+      A("clr %[tmp]")
+      A("mul %[charIn1], %B[intIn2]")
+      A("movw %A[intRes], r0")
+      A("mul %[charIn1], %A[intIn2]")
+      A("add %A[intRes], r1")
+      A("adc %B[intRes], %[tmp]")
+      A("lsr r0")
+      A("adc %A[intRes], %[tmp]")
+      A("adc %B[intRes], %[tmp]")
+      A("clr r1")
+        : [intRes] "=&r" (intRes),
+          [tmp] "=&r" (tmp)
+        : [charIn1] "d" (charIn1),
+          [intIn2] "d" (intIn2)
+        : "cc"
+    );
+    return intRes;
+  #else
+    return ((uint32_t)charIn1 * intIn2 + 0x80) >> 8;
+  #endif
 }
 
 class Stepper {
@@ -312,6 +316,12 @@ class Stepper {
       static uint32_t acc_step_rate; // needed for deceleration start point
     #endif
 
+    #if ENABLED(STEP_RATE_TABLE)
+      static bool use_rate_table;                     // The current block has a rate table
+      static const step_rate_segment_t *rate_segment; // The segment of the rate table in use
+      static uint32_t rate_interval;                  // The next ISR interval (16.16 fixed point)
+    #endif
+
     static volatile int32_t endstops_trigsteps[XYZ];
 
     //
@@ -353,6 +363,16 @@ class Stepper {
     // Check if the given block is busy or not - Must not be called from ISR contexts
     static bool is_block_busy(const block_t* const block);
 
+    #if ENABLED(STEP_RATE_TABLE)
+      // Tabulate the acceleration and deceleration of a planned block for the ISR
+      static void calculate_rate_table(block_t * const block);
+    #endif
+
+    #if ENABLED(PREPARED_BLOCKS)
+      // Work out the ISR setup of a planned block ahead of time
+      static void prepare_block(block_t * const block);
+    #endif
+
     // Get the position of a stepper, in steps
     static int32_t position(const AxisEnum axis);
 
@@ -506,25 +526,62 @@ class Stepper {
       constexpr uint32_t min_step_rate = F_CPU / 500000U;
       NOLESS(step_rate, min_step_rate);
       step_rate -= min_step_rate; // Correct for minimal speed
-      if (step_rate >= (8 * 256)) { // higher step rate
-        const uint8_t tmp_step_rate = (step_rate & 0x00FF);
-        const uint16_t table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
-                       gain = (uint16_t)pgm_read_word_near(table_address + 2);
-        timer = MultiU16X8toH16(tmp_step_rate, gain);
-        timer = (uint16_t)pgm_read_word_near(table_address) - timer;
-      }
-      else { // lower step rates
-        uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
-        table_address += ((step_rate) >> 1) & 0xFFFC;
-        timer = (uint16_t)pgm_read_word_near(table_address)
-              - (((uint16_t)pgm_read_word_near(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
-      }
+      #ifdef __AVR__
+        if (step_rate >= (8 * 256)) { // higher step rate
+          const uint8_t tmp_step_rate = (step_rate & 0x00FF);
+          const uint16_t table_address = (uint16_t)&speed_lookuptable_fast[(uint8_t)(step_rate >> 8)][0],
+                         gain = (uint16_t)pgm_read_word_near(table_address + 2);
+          timer = MultiU16X8toH16(tmp_step_rate, gain);
+          timer = (uint16_t)pgm_read_word_near(table_address) - timer;
+        }
+        else { // lower step rates
+          uint16_t table_address = (uint16_t)&speed_lookuptable_slow[0][0];
+          table_address += ((step_rate) >> 1) & 0xFFFC;
+          timer = (uint16_t)pgm_read_word_near(table_address)
+                - (((uint16_t)pgm_read_word_near(table_address + 2) * (uint8_t)(step_rate & 0x0007)) >> 3);
+        }
+      #else
+        // Same tables, indexed without 16-bit program memory addresses
+        if (step_rate >= (8 * 256)) { // higher step rate
+          const uint8_t tmp_step_rate = (step_rate & 0x00FF);
+          const uint16_t * const table = speed_lookuptable_fast[(uint8_t)(step_rate >> 8)];
+          timer = MultiU16X8toH16(tmp_step_rate, pgm_read_word(&table[1]));
+          timer = pgm_read_word(&table[0]) - timer;
+        }
+        else { // lower step rates
+          const uint16_t * const table = speed_lookuptable_slow[step_rate >> 3];
+          timer = pgm_read_word(&table[0]) - ((pgm_read_word(&table[1]) * (uint8_t)(step_rate & 0x0007)) >> 3);
+        }
+      #endif
       // (there is no need to limit the timer value here. All limits have been
       // applied above, and AVR is able to keep up at 30khz Stepping ISR rate)
 
       return timer;
     }
 
+    #if ENABLED(STEP_RATE_TABLE)
+      static step_rate_segment_t* tabulate_ramp(step_rate_segment_t *seg, const uint32_t first, const uint32_t last, const float &rate0, const float &rate1, const float &accel2);
+
+      // The next interval of an acceleration or deceleration, from the block's rate table
+      FORCE_INLINE static uint32_t rate_table_interval() {
+        if (step_events_completed >= rate_segment->until) {
+          do ++rate_segment; while (step_events_completed >= rate_segment->until);
+          rate_interval = rate_segment->interval;
+        }
+        steps_per_isr = rate_segment->loops;
+        const uint32_t interval = rate_interval >> 16;
+        rate_interval += rate_segment->delta;
+        return interval;
+      }
+    #endif
+
+    // The axes a block moves, for endstop handling
+    static uint8_t block_move_bits(const block_t * const block);
+
+    #if ENABLED(ADAPTIVE_STEP_SMOOTHING)
+      static uint8_t block_oversampling(const block_t * const block);
+    #endif
+
     #if ENABLED(S_CURVE_ACCELERATION)
       static void _calc_bezier_curve_coeffs(const int32_t v0, const int32_t v1, const uint32_t av);
       static int32_t _eval_bezier_curve(const uint32_t curr_step);
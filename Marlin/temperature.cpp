@@ -51,11 +51,21 @@
   #include "watchdog.h"
 #endif
 
+#if ENABLED(PROFILE_HOT_PATHS)
+  #include "profiler.h"
+#endif
+
 #if ENABLED(EMERGENCY_PARSER)
   #include "emergency_parser.h"
 #endif
 
-#if HOTEND_USES_THERMISTOR
+#if HOTEND_USES_THERMISTOR && ENABLED(UNIFORM_THERMISTOR_TABLES)
+  #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
+    static const short * const heater_uniform_ttbl_map[2] = { HEATER_0_UNIFORM_TEMPTABLE, HEATER_1_UNIFORM_TEMPTABLE };
+  #else
+    static const short * const heater_uniform_ttbl_map[HOTENDS] = ARRAY_BY_HOTENDS(HEATER_0_UNIFORM_TEMPTABLE, HEATER_1_UNIFORM_TEMPTABLE, HEATER_2_UNIFORM_TEMPTABLE, HEATER_3_UNIFORM_TEMPTABLE, HEATER_4_UNIFORM_TEMPTABLE);
+  #endif
+#elif HOTEND_USES_THERMISTOR
   #if ENABLED(TEMP_SENSOR_1_AS_REDUNDANT)
     static void* heater_ttbl_map[2] = { (void*)HEATER_0_TEMPTABLE, (void*)HEATER_1_TEMPTABLE };
     static constexpr uint8_t heater_ttbllen_map[2] = { HEATER_0_TEMPTABLE_LEN, HEATER_1_TEMPTABLE_LEN };
@@ -917,6 +927,20 @@ void Temperature::manage_heater() {
   }                                                                    \
 }while(0)
 
+#if ENABLED(UNIFORM_THERMISTOR_TABLES)
+
+  /**
+   * Index a table with one entry per ADC count by the raw value, then
+   * interpolate by the oversampled fraction in fixed point.
+   */
+  static float uniform_table_celsius(const short * const tbl, const int raw) {
+    const uint16_t r = MIN(raw, (UNIFORM_TEMPTABLE_LEN - 1) * (OVERSAMPLENR) - 1), i = r / (OVERSAMPLENR);
+    const short t0 = pgm_read_word(&tbl[i]), t1 = pgm_read_word(&tbl[i + 1]);
+    return (int32_t(t0) * (OVERSAMPLENR) + int32_t(t1 - t0) * (r % (OVERSAMPLENR))) * (1.0f / ((UNIFORM_TEMPTABLE_SCALE) * (OVERSAMPLENR)));
+  }
+
+#endif
+
 // Derived from RepRap FiveD extruder::getTemperature()
 // For hot end temperature measurement.
 float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
@@ -989,7 +1013,9 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
     default: break;
   }
 
-  #if HOTEND_USES_THERMISTOR
+  #if HOTEND_USES_THERMISTOR && ENABLED(UNIFORM_THERMISTOR_TABLES)
+    return uniform_table_celsius(heater_uniform_ttbl_map[e], raw);
+  #elif HOTEND_USES_THERMISTOR
     // Thermistor with conversion table?
     const short(*tt)[][2] = (short(*)[][2])(heater_ttbl_map[e]);
     SCAN_THERMISTOR_TABLE((*tt), heater_ttbllen_map[e]);
@@ -1002,7 +1028,9 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
   // Derived from RepRap FiveD extruder::getTemperature()
   // For bed temperature measurement.
   float Temperature::analog_to_celsius_bed(const int raw) {
-    #if ENABLED(HEATER_BED_USES_THERMISTOR)
+    #if ENABLED(HEATER_BED_USES_THERMISTOR) && ENABLED(UNIFORM_THERMISTOR_TABLES)
+      return uniform_table_celsius(BED_UNIFORM_TEMPTABLE, raw);
+    #elif ENABLED(HEATER_BED_USES_THERMISTOR)
       SCAN_THERMISTOR_TABLE(BEDTEMPTABLE, BEDTEMPTABLE_LEN);
     #elif ENABLED(HEATER_BED_USES_ADS1118)
       return Ads1118::ADC_steps_to_C(raw/OVERSAMPLENR);
@@ -1020,7 +1048,9 @@ float Temperature::analog_to_celsius_hotend(const int raw, const uint8_t e) {
   // Derived from RepRap FiveD extruder::getTemperature()
   // For chamber temperature measurement.
   float Temperature::analog_to_celsius_chamber(const int raw) {
-    #if ENABLED(HEATER_CHAMBER_USES_THERMISTOR)
+    #if ENABLED(HEATER_CHAMBER_USES_THERMISTOR) && ENABLED(UNIFORM_THERMISTOR_TABLES)
+      return uniform_table_celsius(CHAMBER_UNIFORM_TEMPTABLE, raw);
+    #elif ENABLED(HEATER_CHAMBER_USES_THERMISTOR)
       SCAN_THERMISTOR_TABLE(CHAMBERTEMPTABLE, CHAMBERTEMPTABLE_LEN);
     #elif ENABLED(HEATER_CHAMBER_USES_ADS1118)
       return Ads1118::ADC_steps_to_C(raw/OVERSAMPLENR);
@@ -1933,6 +1963,10 @@ HAL_TEMP_TIMER_ISR {
 
 void Temperature::isr() {
 
+  #if ENABLED(PROFILE_HOT_PATHS)
+    ProfileScope profile_scope(PROFILE_TEMPERATURE_ISR);
+  #endif
+
   static int8_t temp_count = -1;
   static ADCSensorState adc_sensor_state = StartupDelay;
   static uint8_t pwm_count = _BV(SOFT_PWM_SCALE);
@@ -203,6 +203,94 @@
   #define CHAMBERTEMPTABLE_LEN 0
 #endif
 
+#if ENABLED(UNIFORM_THERMISTOR_TABLES)
+
+  /**
+   * Tables resampled to one entry per ADC count (0-1024), in 1/16 degC.
+   * Values are interpolated like SCAN_THERMISTOR_TABLE, except that raw
+   * values past either end of a table read as that end's temperature.
+   */
+  #define UNIFORM_TEMPTABLE_LEN 1025
+  #define UNIFORM_TEMPTABLE_SCALE 16
+
+  constexpr short uniform_temp_round(const float t) {
+    return short(t < 0 ? t * (UNIFORM_TEMPTABLE_SCALE) - 0.5f : t * (UNIFORM_TEMPTABLE_SCALE) + 0.5f);
+  }
+
+  template<size_t N>
+  constexpr short uniform_temp(const short (&tbl)[N][2], const long raw, const size_t i=1) {
+    return raw <= tbl[0][0] ? tbl[0][1] * (UNIFORM_TEMPTABLE_SCALE)
+         : i >= N ? tbl[N - 1][1] * (UNIFORM_TEMPTABLE_SCALE)
+         : raw <= tbl[i][0] ? uniform_temp_round(tbl[i - 1][1] + (raw - tbl[i - 1][0]) * float(tbl[i][1] - tbl[i - 1][1]) / float(tbl[i][0] - tbl[i - 1][0]))
+         : uniform_temp(tbl, raw, i + 1);
+  }
+
+  #define _UTT1(T,A)   uniform_temp(T, OV(A))
+  #define _UTT4(T,A)   _UTT1(T,A), _UTT1(T,(A)+1), _UTT1(T,(A)+2), _UTT1(T,(A)+3)
+  #define _UTT16(T,A)  _UTT4(T,A), _UTT4(T,(A)+4), _UTT4(T,(A)+8), _UTT4(T,(A)+12)
+  #define _UTT64(T,A)  _UTT16(T,A), _UTT16(T,(A)+16), _UTT16(T,(A)+32), _UTT16(T,(A)+48)
+  #define _UTT256(T,A) _UTT64(T,A), _UTT64(T,(A)+64), _UTT64(T,(A)+128), _UTT64(T,(A)+192)
+
+  #define _UTT_NAME(_N) uniform_temptable_ ## _N
+  #define UTT_NAME(_N) _UTT_NAME(_N)
+  #define UNIFORM_TEMPTABLE(_N) const short UTT_NAME(_N)[UNIFORM_TEMPTABLE_LEN] PROGMEM = { \
+    _UTT256(TT_NAME(_N), 0), _UTT256(TT_NAME(_N), 256), _UTT256(TT_NAME(_N), 512), _UTT256(TT_NAME(_N), 768), _UTT1(TT_NAME(_N), 1024) \
+  }
+
+  // One table for each thermistor type in use
+  #if THERMISTORHEATER_0
+    UNIFORM_TEMPTABLE(THERMISTORHEATER_0);
+    #define HEATER_0_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORHEATER_0)
+  #else
+    #define HEATER_0_UNIFORM_TEMPTABLE NULL
+  #endif
+  #if THERMISTORHEATER_1
+    #if THERMISTORHEATER_1 != THERMISTORHEATER_0
+      UNIFORM_TEMPTABLE(THERMISTORHEATER_1);
+    #endif
+    #define HEATER_1_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORHEATER_1)
+  #else
+    #define HEATER_1_UNIFORM_TEMPTABLE NULL
+  #endif
+  #if THERMISTORHEATER_2
+    #if THERMISTORHEATER_2 != THERMISTORHEATER_0 && THERMISTORHEATER_2 != THERMISTORHEATER_1
+      UNIFORM_TEMPTABLE(THERMISTORHEATER_2);
+    #endif
+    #define HEATER_2_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORHEATER_2)
+  #else
+    #define HEATER_2_UNIFORM_TEMPTABLE NULL
+  #endif
+  #if THERMISTORHEATER_3
+    #if THERMISTORHEATER_3 != THERMISTORHEATER_0 && THERMISTORHEATER_3 != THERMISTORHEATER_1 && THERMISTORHEATER_3 != THERMISTORHEATER_2
+      UNIFORM_TEMPTABLE(THERMISTORHEATER_3);
+    #endif
+    #define HEATER_3_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORHEATER_3)
+  #else
+    #define HEATER_3_UNIFORM_TEMPTABLE NULL
+  #endif
+  #if THERMISTORHEATER_4
+    #if THERMISTORHEATER_4 != THERMISTORHEATER_0 && THERMISTORHEATER_4 != THERMISTORHEATER_1 && THERMISTORHEATER_4 != THERMISTORHEATER_2 && THERMISTORHEATER_4 != THERMISTORHEATER_3
+      UNIFORM_TEMPTABLE(THERMISTORHEATER_4);
+    #endif
+    #define HEATER_4_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORHEATER_4)
+  #else
+    #define HEATER_4_UNIFORM_TEMPTABLE NULL
+  #endif
+  #ifdef THERMISTORBED
+    #if THERMISTORBED != THERMISTORHEATER_0 && THERMISTORBED != THERMISTORHEATER_1 && THERMISTORBED != THERMISTORHEATER_2 && THERMISTORBED != THERMISTORHEATER_3 && THERMISTORBED != THERMISTORHEATER_4
+      UNIFORM_TEMPTABLE(THERMISTORBED);
+    #endif
+    #define BED_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORBED)
+  #endif
+  #ifdef THERMISTORCHAMBER
+    #if THERMISTORCHAMBER != THERMISTORHEATER_0 && THERMISTORCHAMBER != THERMISTORHEATER_1 && THERMISTORCHAMBER != THERMISTORHEATER_2 && THERMISTORCHAMBER != THERMISTORHEATER_3 && THERMISTORCHAMBER != THERMISTORHEATER_4 && (!defined(THERMISTORBED) || THERMISTORCHAMBER != THERMISTORBED)
+      UNIFORM_TEMPTABLE(THERMISTORCHAMBER);
+    #endif
+    #define CHAMBER_UNIFORM_TEMPTABLE UTT_NAME(THERMISTORCHAMBER)
+  #endif
+
+#endif // UNIFORM_THERMISTOR_TABLES
+
 // The SCAN_THERMISTOR_TABLE macro needs alteration?
 static_assert(HEATER_0_TEMPTABLE_LEN < 256 && HEATER_1_TEMPTABLE_LEN < 256 && HEATER_2_TEMPTABLE_LEN < 256 && HEATER_3_TEMPTABLE_LEN < 256 && HEATER_4_TEMPTABLE_LEN < 256 && BEDTEMPTABLE_LEN < 256 && CHAMBERTEMPTABLE_LEN < 256,
   "Temperature conversion tables over 255 entries need special consideration."
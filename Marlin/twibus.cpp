@@ -25,11 +25,29 @@
 #if ENABLED(EXPERIMENTAL_I2CBUS)
 
 #include "twibus.h"
-#include <Wire.h>
+#if ENABLED(TWIBUS_ASYNC)
+  #include <util/twi.h>
+  #include "pins_arduino.h"
+#else
+  #include <Wire.h>
+#endif
 #include "Marlin.h"
 
+#if ENABLED(TWIBUS_ASYNC)
+  twi_transaction_t TWIBus::transactions[TWIBUS_QUEUE_SIZE];
+  volatile uint8_t TWIBus::queue_head, // = 0
+                   TWIBus::queue_tail; // = 0
+#endif
+
 TWIBus::TWIBus() {
-  #if I2C_SLAVE_ADDRESS == 0
+  #if ENABLED(TWIBUS_ASYNC)
+    // Join the bus as the master, with the internal pullups on like Wire
+    digitalWrite(PIN_WIRE_SDA, HIGH);
+    digitalWrite(PIN_WIRE_SCL, HIGH);
+    TWSR = 0; // Prescaler 1
+    TWBR = ((F_CPU) / (TWIBUS_CLOCK) - 16) / 2;
+    TWCR = _BV(TWEN) | _BV(TWIE);
+  #elif I2C_SLAVE_ADDRESS == 0
     Wire.begin();                  // No address joins the BUS as the master
   #else
     Wire.begin(I2C_SLAVE_ADDRESS); // Join the bus as a slave
@@ -82,9 +100,13 @@ void TWIBus::send() {
     debug(PSTR("send"), this->addr);
   #endif
 
-  Wire.beginTransmission(this->addr);
-  Wire.write(this->buffer, this->buffer_s);
-  Wire.endTransmission();
+  #if ENABLED(TWIBUS_ASYNC)
+    queue(this->addr, (byte*)this->buffer, this->buffer_s, 0);
+  #else
+    Wire.beginTransmission(this->addr);
+    Wire.write(this->buffer, this->buffer_s);
+    Wire.endTransmission();
+  #endif
 
   this->reset();
 }
@@ -98,12 +120,16 @@ void TWIBus::echoprefix(uint8_t bytes, const char prefix[], uint8_t adr) {
   SERIAL_ECHOPGM (" data:");
 }
 
-// static
-void TWIBus::echodata(uint8_t bytes, const char prefix[], uint8_t adr) {
-  echoprefix(bytes, prefix, adr);
-  while (bytes-- && Wire.available()) SERIAL_CHAR(Wire.read());
-  SERIAL_EOL();
-}
+#if DISABLED(TWIBUS_ASYNC)
+
+  // static
+  void TWIBus::echodata(uint8_t bytes, const char prefix[], uint8_t adr) {
+    echoprefix(bytes, prefix, adr);
+    while (bytes-- && Wire.available()) SERIAL_CHAR(Wire.read());
+    SERIAL_EOL();
+  }
+
+#endif
 
 void TWIBus::echobuffer(const char prefix[], uint8_t adr) {
   echoprefix(this->buffer_s, prefix, adr);
@@ -118,8 +144,16 @@ bool TWIBus::request(const uint8_t bytes) {
     debug(PSTR("request"), bytes);
   #endif
 
-  // requestFrom() is a blocking function
-  if (Wire.requestFrom(this->addr, bytes) == 0) {
+  #if ENABLED(TWIBUS_ASYNC)
+    // The reply goes to the buffer, for capture()
+    const bool ok = transfer(this->addr, NULL, 0, (byte*)this->buffer, bytes);
+    this->buffer_s = ok ? bytes : 0;
+  #else
+    // requestFrom() is a blocking function
+    const bool ok = Wire.requestFrom(this->addr, bytes) != 0;
+  #endif
+
+  if (!ok) {
     #if ENABLED(DEBUG_TWIBUS)
       debug("request fail", this->addr);
     #endif
@@ -134,15 +168,27 @@ void TWIBus::relay(const uint8_t bytes) {
     debug(PSTR("relay"), bytes);
   #endif
 
-  if (this->request(bytes))
-    echodata(bytes, PSTR("i2c-reply"), this->addr);
+  if (this->request(bytes)) {
+    #if ENABLED(TWIBUS_ASYNC)
+      echobuffer(PSTR("i2c-reply"), this->addr);
+      this->reset();
+    #else
+      echodata(bytes, PSTR("i2c-reply"), this->addr);
+    #endif
+  }
 }
 
 uint8_t TWIBus::capture(byte *dst, const uint8_t bytes) {
-  this->reset();
-  uint8_t count = 0;
-  while (count < bytes && Wire.available())
-    dst[count++] = Wire.read();
+  #if ENABLED(TWIBUS_ASYNC)
+    const uint8_t count = MIN(bytes, this->buffer_s);
+    memcpy(dst, this->buffer, count);
+    this->reset();
+  #else
+    this->reset();
+    uint8_t count = 0;
+    while (count < bytes && Wire.available())
+      dst[count++] = Wire.read();
+  #endif
 
   #if ENABLED(DEBUG_TWIBUS)
     debug(PSTR("capture"), count);
@@ -153,9 +199,152 @@ uint8_t TWIBus::capture(byte *dst, const uint8_t bytes) {
 
 // static
 void TWIBus::flush() {
-  while (Wire.available()) Wire.read();
+  #if DISABLED(TWIBUS_ASYNC)
+    while (Wire.available()) Wire.read();
+  #endif
 }
 
+#if ENABLED(TWIBUS_ASYNC)
+
+  #define TWI_GO        (_BV(TWEN) | _BV(TWIE) | _BV(TWINT))  // Clearing TWINT starts the next bus event
+  #define TWI_NEXT(I)   ((I) + 1 == TWIBUS_QUEUE_SIZE ? 0 : (I) + 1)
+
+  static uint8_t twi_sent; // Bytes of the current transaction written so far
+
+  // static
+  bool TWIBus::queue(const uint8_t adr, const byte *src, const uint8_t send_s, const uint8_t request_s, const twiDoneFunc_t done/*=NULL*/, const uint8_t tag/*=0*/) {
+    if (send_s > TWIBUS_BUFFER_SIZE || request_s > TWIBUS_BUFFER_SIZE) return false;
+
+    #if ENABLED(DEBUG_TWIBUS)
+      debug(PSTR("queue"), adr);
+    #endif
+
+    // Wait for a free slot like the planner does for a free block
+    while (TWI_NEXT(queue_tail) == queue_head) idle();
+
+    const uint8_t tail = queue_tail, next = TWI_NEXT(tail);
+
+    twi_transaction_t &t = transactions[tail];
+    t.addr = adr;
+    t.send_s = send_s;
+    t.request_s = request_s;
+    t.count = 0;
+    t.ok = false;
+    t.tag = tag;
+    t.done = done;
+    if (send_s) memcpy(t.data, src, send_s);
+
+    CRITICAL_SECTION_START;
+    const bool was_busy = busy();
+    queue_tail = next;
+    if (!was_busy) start();
+    CRITICAL_SECTION_END;
+
+    return true;
+  }
+
+  // Start the transaction at the head of the queue
+  // static
+  void TWIBus::start() {
+    twi_sent = 0;
+    while (TEST(TWCR, TWSTO)) { /* nada */ } // Let a STOP finish
+    TWCR = TWI_GO | _BV(TWSTA);
+  }
+
+  // Release the bus, or hand it straight to the next transaction, then report
+  // static
+  void TWIBus::finish(const bool ok) {
+    twi_transaction_t &t = transactions[queue_head];
+    t.ok = ok;
+    const uint8_t next = TWI_NEXT(queue_head);
+    if (next != queue_tail) {
+      twi_sent = 0;
+      TWCR = TWI_GO | _BV(TWSTO) | _BV(TWSTA); // STOP followed by START
+    }
+    else
+      TWCR = TWI_GO | _BV(TWSTO);
+
+    if (t.done) (*t.done)(t);
+    queue_head = next;
+  }
+
+  // static
+  void TWIBus::isr() {
+    twi_transaction_t &t = transactions[queue_head];
+    switch (TW_STATUS) {
+      case TW_START:
+        // Write first, if there's anything to write
+        TWDR = (t.addr << 1) | (t.send_s || !t.request_s ? TW_WRITE : TW_READ);
+        TWCR = TWI_GO;
+        break;
+
+      case TW_REP_START:
+        TWDR = (t.addr << 1) | TW_READ;
+        TWCR = TWI_GO;
+        break;
+
+      case TW_MT_SLA_ACK:
+      case TW_MT_DATA_ACK:
+        if (twi_sent < t.send_s) {
+          TWDR = t.data[twi_sent++];
+          TWCR = TWI_GO;
+        }
+        else if (t.request_s)
+          TWCR = TWI_GO | _BV(TWSTA); // Repeated start to read the reply
+        else
+          finish(true);
+        break;
+
+      case TW_MR_DATA_ACK:
+        t.data[t.count++] = TWDR;
+        // fall-through
+      case TW_MR_SLA_ACK:
+        // Acknowledge every byte but the last
+        TWCR = t.count + 1 < t.request_s ? TWI_GO | _BV(TWEA) : TWI_GO;
+        break;
+
+      case TW_MR_DATA_NACK:
+        t.data[t.count++] = TWDR;
+        finish(true);
+        break;
+
+      default: // No acknowledge, lost arbitration or bus error
+        finish(false);
+        break;
+    }
+  }
+
+  ISR(TWI_vect) { TWIBus::isr(); }
+
+  static volatile bool transfer_pending;
+  static bool transfer_ok;
+  static byte *transfer_dst;
+
+  static void transfer_done(const twi_transaction_t &t) {
+    if (transfer_dst) memcpy(transfer_dst, t.data, t.count);
+    transfer_ok = t.ok;
+    transfer_pending = false;
+  }
+
+  // static
+  bool TWIBus::transfer(const uint8_t adr, const byte *src, const uint8_t send_s, byte *dst/*=NULL*/, const uint8_t request_s/*=0*/) {
+    transfer_dst = dst;
+    transfer_pending = true;
+    if (!queue(adr, src, send_s, request_s, transfer_done)) {
+      transfer_pending = false;
+      return false;
+    }
+    while (transfer_pending) idle();
+    return transfer_ok;
+  }
+
+  // static
+  void TWIBus::synchronize() {
+    while (busy()) idle();
+  }
+
+#endif // TWIBUS_ASYNC
+
 #if I2C_SLAVE_ADDRESS > 0
 
   void TWIBus::receive(uint8_t bytes) {
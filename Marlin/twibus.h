@@ -25,7 +25,9 @@
 
 #include "macros.h"
 
-#include <Wire.h>
+#if DISABLED(TWIBUS_ASYNC)
+  #include <Wire.h>
+#endif
 
 // Print debug messages with M111 S2 (Uses 236 bytes of PROGMEM)
 //#define DEBUG_TWIBUS
@@ -42,6 +44,29 @@ typedef void (*twiRequestFunc_t)();
 
 #define TWIBUS_BUFFER_SIZE 32
 
+#if ENABLED(TWIBUS_ASYNC)
+
+  struct twi_transaction_t;
+  typedef void (*twiDoneFunc_t)(const twi_transaction_t &t);
+
+  /**
+   * A queued transaction: write 'send_s' bytes, then read 'request_s' bytes
+   * after a repeated start. Either may be 0. With both 0 it only checks that
+   * a device answers to the address.
+   */
+  typedef struct twi_transaction_t {
+    uint8_t addr,                       // 7-bit slave address
+            send_s,                     // Bytes to write
+            request_s,                  // Bytes to read after writing
+            count;                      // Bytes read
+    bool ok;                            // The slave acknowledged everything
+    uint8_t tag;                        // Free for the caller, e.g., an axis
+    twiDoneFunc_t done;                 // Called from the TWI interrupt when finished
+    byte data[TWIBUS_BUFFER_SIZE];      // Bytes to write, then the bytes read
+  } twi_transaction_t;
+
+#endif
+
 /**
  * TWIBUS class
  *
@@ -58,6 +83,9 @@ typedef void (*twiRequestFunc_t)();
  *    - http://marlinfw.org/docs/gcode/M260.html
  *    - http://marlinfw.org/docs/gcode/M261.html
  *
+ * With TWIBUS_ASYNC the Wire library is replaced by a queue of transactions
+ * run from the TWI interrupt. send() then returns at once, while request()
+ * keeps the machine alive with idle() until the reply is in.
  */
 class TWIBus {
   private:
@@ -143,14 +171,16 @@ class TWIBus {
      */
     static void echoprefix(uint8_t bytes, const char prefix[], uint8_t adr);
 
-    /**
-     * @brief Echo data on the bus to serial
-     * @details Echo some number of bytes from the bus
-     *          to serial in a parser-friendly format.
-     *
-     * @param bytes the number of bytes to request
-     */
-    static void echodata(uint8_t bytes, const char prefix[], uint8_t adr);
+    #if DISABLED(TWIBUS_ASYNC)
+      /**
+       * @brief Echo data on the bus to serial
+       * @details Echo some number of bytes from the bus
+       *          to serial in a parser-friendly format.
+       *
+       * @param bytes the number of bytes to request
+       */
+      static void echodata(uint8_t bytes, const char prefix[], uint8_t adr);
+    #endif
 
     /**
      * @brief Echo data in the buffer to serial
@@ -231,6 +261,62 @@ class TWIBus {
 
     #endif
 
+    #if ENABLED(TWIBUS_ASYNC)
+
+      /**
+       * @brief Queue a transaction
+       * @details Copy the bytes to write and return without waiting for the
+       *          bus. 'done' is called from the TWI interrupt when the
+       *          transaction finishes, so it must be short. If the queue
+       *          is full, calls idle() until a slot is free.
+       *
+       * @param adr 7-bit slave address
+       * @param src the bytes to write
+       * @param send_s the number of bytes to write
+       * @param request_s the number of bytes to read afterwards
+       * @param done completion callback, or NULL
+       * @param tag passed on to the callback in the transaction
+       * @return false if the transaction doesn't fit the buffer
+       */
+      static bool queue(const uint8_t adr, const byte *src, const uint8_t send_s, const uint8_t request_s, const twiDoneFunc_t done=NULL, const uint8_t tag=0);
+
+      /**
+       * @brief Run a transaction and wait for it
+       * @details Queue a transaction and call idle() until it's done.
+       *          The bytes read are copied to 'dst'. Not for use from
+       *          idle() itself, which should queue() instead.
+       *
+       * @return status of the transaction: true=success, false=fail
+       */
+      static bool transfer(const uint8_t adr, const byte *src, const uint8_t send_s, byte *dst=NULL, const uint8_t request_s=0);
+
+      /**
+       * @brief Wait for the queue to empty
+       * @details Call idle() until every queued transaction is done
+       */
+      static void synchronize();
+
+      FORCE_INLINE static bool busy() { return queue_head != queue_tail; }
+
+      /**
+       * @brief TWI interrupt handler
+       * @details Move the transaction at the head of the queue on by one
+       *          bus event, and start the next one when it's done.
+       */
+      static void isr();
+
+    private:
+      static twi_transaction_t transactions[TWIBUS_QUEUE_SIZE];
+      static volatile uint8_t queue_head,   // The transaction on the bus. Moved on by the ISR.
+                              queue_tail;   // The next free slot. Moved on by queue().
+
+      static void start();
+      static void finish(const bool ok);
+
+    public:
+
+    #endif
+
     #if ENABLED(DEBUG_TWIBUS)
 
       /**
@@ -118,6 +118,11 @@
 
   float unified_bed_leveling::z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+  float unified_bed_leveling::cell_z[4] = { NAN, NAN, NAN, NAN },
+        unified_bed_leveling::cell_b,
+        unified_bed_leveling::cell_c,
+        unified_bed_leveling::cell_d;
+
   // 15 is the maximum nubmer of grid points supported + 1 safety margin for now,
   // until determinism prevails
   constexpr float unified_bed_leveling::_mesh_index_to_xpos[16],
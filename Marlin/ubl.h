@@ -125,6 +125,9 @@ class unified_bed_leveling {
 
     static float z_values[GRID_MAX_POINTS_X][GRID_MAX_POINTS_Y];
 
+    // Corners and coefficients of the last cell used by get_z_correction
+    static float cell_z[4], cell_b, cell_c, cell_d;
+
     // 15 is the maximum nubmer of grid points supported + 1 safety margin for now,
     // until determinism prevails
     static constexpr float _mesh_index_to_xpos[16] PROGMEM = {
@@ -273,10 +276,12 @@ class unified_bed_leveling {
     }
 
     /**
-     * This is the generic Z-Correction. It works anywhere within a Mesh Cell. It first
-     * does a linear interpolation along both of the bounding X-Mesh-Lines to find the
-     * Z-Height at both ends. Then it does a linear interpolation of these heights based
-     * on the Y position within the cell.
+     * This is the generic Z-Correction. It works anywhere within a Mesh Cell. The
+     * Z-Height is z1 + b * tx + (c + d * tx) * ty, with tx and ty the position within
+     * the cell and z1 its front-left corner. This is the same as a linear interpolation
+     * along both of the bounding X-Mesh-Lines followed by one along Y, with no divisions.
+     * The coefficients are only worked out again when the corners change, which they
+     * rarely do from one segment to the next.
      */
     static float get_z_correction(const float &rx0, const float &ry0) {
       const int8_t cx = get_cell_index_x(rx0),
@@ -291,17 +296,26 @@ class unified_bed_leveling {
           return UBL_Z_RAISE_WHEN_OFF_MESH;
       #endif
 
-      const float z1 = calc_z0(rx0,
-                               mesh_index_to_xpos(cx), z_values[cx][cy],
-                               mesh_index_to_xpos(cx + 1), z_values[MIN(cx, GRID_MAX_POINTS_X - 2) + 1][cy]);
+      // Position within the cell. Beyond the mesh it extrapolates from the edge cell.
+      const float tx = (rx0 - (MESH_MIN_X)) * (1.0f / (MESH_X_DIST)) - cx,
+                  ty = (ry0 - (MESH_MIN_Y)) * (1.0f / (MESH_Y_DIST)) - cy;
+
+      // Don't allow cx+1 or cy+1 to be past the end of the array. At the last mesh line
+      // the far corner is the near one, and no correction is applied in that direction.
+      const uint8_t nx = MIN(cx, GRID_MAX_POINTS_X - 2) + 1,
+                    ny = MIN(cy, GRID_MAX_POINTS_Y - 2) + 1;
 
-      const float z2 = calc_z0(rx0,
-                               mesh_index_to_xpos(cx), z_values[cx][MIN(cy, GRID_MAX_POINTS_Y - 2) + 1],
-                               mesh_index_to_xpos(cx + 1), z_values[MIN(cx, GRID_MAX_POINTS_X - 2) + 1][MIN(cy, GRID_MAX_POINTS_Y - 2) + 1]);
+      const float z1 = z_values[cx][cy], z2 = z_values[nx][cy],
+                  z3 = z_values[cx][ny], z4 = z_values[nx][ny];
+
+      if (z1 != cell_z[0] || z2 != cell_z[1] || z3 != cell_z[2] || z4 != cell_z[3]) {
+        cell_z[0] = z1; cell_z[1] = z2; cell_z[2] = z3; cell_z[3] = z4;
+        cell_b = z2 - z1;
+        cell_c = z3 - z1;
+        cell_d = z4 - z2 - cell_c;
+      }
 
-      float z0 = calc_z0(ry0,
-                         mesh_index_to_ypos(cy), z1,
-                         mesh_index_to_ypos(cy + 1), z2);
+      float z0 = z1 + cell_b * tx + (cell_c + cell_d * tx) * ty;
 
       #if ENABLED(DEBUG_LEVELING_FEATURE)
         if (DEBUGGING(MESH_ADJUST)) {
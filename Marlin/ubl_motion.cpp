@@ -375,6 +375,10 @@
         const float (&raw)[XYZE] = in_raw;
       #endif
 
+      #if ENABLED(CARTESIAN_JUNCTIONS)
+        planner.set_cartesian_direction(in_raw);
+      #endif
+
       #if ENABLED(DELTA)  // apply delta inverse_kinematics
 
         DELTA_IK(raw);
@@ -5360,15 +5360,21 @@ void lcd_update() {
       #endif
 
       #if ENABLED(DOGLCD)
-        #if ENABLED(LIGHTWEIGHT_UI)
+        #if ENABLED(LIGHTWEIGHT_UI) || ENABLED(DOGM_STATUS_DIRTY_PAGES)
           #if ENABLED(ULTIPANEL)
             const bool in_status = currentScreen == lcd_status_screen;
           #else
             constexpr bool in_status = true;
           #endif
+        #endif
+        #if ENABLED(LIGHTWEIGHT_UI)
           const bool do_u8g_loop = !in_status;
           lcd_in_status(in_status);
           if (in_status) lcd_status_screen();
+        #elif ENABLED(DOGM_STATUS_DIRTY_PAGES)
+          // Skip the picture loop if the Info Screen hasn't changed, but still process input
+          const bool do_u8g_loop = drawing_screen || lcd_implementation_status_changed(in_status);
+          if (!do_u8g_loop) lcd_status_screen();
         #else
           constexpr bool do_u8g_loop = true;
         #endif
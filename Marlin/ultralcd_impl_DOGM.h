@@ -168,6 +168,7 @@
                                                                             // No 4 stripe device available from u8glib.
   //U8GLIB_ST7920_128X64_1X u8g(LCD_PINS_D4, LCD_PINS_ENABLE, LCD_PINS_RS);    // Original u8glib device. 8 stripes
   U8GLIB_ST7920_128X64_RRD u8g(0); // Number of stripes can be adjusted in ultralcd_st7920_u8glib_rrd.h with PAGE_HEIGHT
+  #define DOGM_SKIP_CLEAN_PAGES         // Pages that haven't changed don't have to be sent
 #elif ENABLED(CARTESIO_UI)
   // The CartesioUI display
   #if defined(DOGLCD_MOSI) && DOGLCD_MOSI > -1 && defined(DOGLCD_SCK) && DOGLCD_SCK > -1
@@ -113,6 +113,9 @@ static void ST7920_SWSPI_SND_8BIT(uint8_t val) {
 #define ST7920_WRITE_BYTE(a)     { ST7920_SWSPI_SND_8BIT((uint8_t)((a)&0xF0u)); ST7920_SWSPI_SND_8BIT((uint8_t)((a)<<4u)); U8G_DELAY(); }
 #define ST7920_WRITE_BYTES(p,l)  { for (uint8_t i = l + 1; --i;) { ST7920_SWSPI_SND_8BIT(*p&0xF0); ST7920_SWSPI_SND_8BIT(*p<<4); p++; } U8G_DELAY(); }
 
+// Set to leave the next page on the display as it is, e.g., when it hasn't changed
+bool u8g_dev_rrd_st7920_skip_page; // = false
+
 uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, void *arg) {
   uint8_t i, y;
   switch (msg) {
@@ -145,7 +148,14 @@ uint8_t u8g_dev_rrd_st7920_128x64_fn(u8g_t *u8g, u8g_dev_t *dev, uint8_t msg, vo
 
     case U8G_DEV_MSG_STOP: break;
 
+    case U8G_DEV_MSG_PAGE_FIRST: u8g_dev_rrd_st7920_skip_page = false; break;
+
     case U8G_DEV_MSG_PAGE_NEXT: {
+      if (u8g_dev_rrd_st7920_skip_page) {
+        u8g_dev_rrd_st7920_skip_page = false;
+        break;
+      }
+
       uint8_t* ptr;
       u8g_pb_t* pb = (u8g_pb_t*)(dev->dev_mem);
       y = pb->p.page_y0;
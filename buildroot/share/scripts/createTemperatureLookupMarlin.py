@@ -16,10 +16,16 @@ Options:
   --t2=ttt:rrr      middle temperature temperature:resistance point (around 150 degC)
   --t3=ttt:rrr      high temperature temperature:resistance point (around 250 degC)
   --num-temps=...   the number of temperature points to calculate (default: 36)
+  --check=nnn       report the conversion error of UNIFORM_THERMISTOR_TABLES
+                    for Marlin's thermistortable_nnn.h, or for all tables with 'all'
 """
 
+from __future__ import print_function
 from math import *
 import sys
+import os
+import re
+import glob
 import getopt
 
 "Constants"
@@ -30,6 +36,9 @@ ARES   = pow(2,10)                          # 10 Bit ADC resolution
 VSTEP  = VADC / ARES                        # ADC voltage resolution
 TMIN   = 0                                  # lowest temperature in table
 TMAX   = 350                                # highest temperature in table
+OVERSAMPLENR = 16                           # ADC readings summed for each raw value
+UNIFORM_SCALE = 16                          # uniform table entries are in 1/16 degC
+MARLIN = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', '..', '..', 'Marlin')
 
 class Thermistor:
     "Class to do the thermistor maths"
@@ -47,9 +56,9 @@ class Thermistor:
         a = y1 - (b + l1**2 *c)*l1
 
         if c < 0:
-            print "//////////////////////////////////////////////////////////////////////////////////////"
-            print "// WARNING: negative coefficient 'c'! Something may be wrong with the measurements! //"
-            print "//////////////////////////////////////////////////////////////////////////////////////"
+            print("//////////////////////////////////////////////////////////////////////////////////////")
+            print("// WARNING: negative coefficient 'c'! Something may be wrong with the measurements! //")
+            print("//////////////////////////////////////////////////////////////////////////////////////")
             c = -c
         self.c1 = a                         # Steinhart-Hart coefficients
         self.c2 = b
@@ -83,6 +92,69 @@ class Thermistor:
         r = exp((y-x)**(1.0/3) - (y+x)**(1.0/3))
         return (r / (self.rp + r)) * ARES
 
+def pt_ad_val(t, r0, rup):
+    "ADC value of a Pt100/Pt1000 sensor, as PtAdVal in thermistortables.h"
+    rt = r0 * (1.0 + 3.9083E-3 * t + -5.775E-7 * t * t)
+    return int(1024 / (rup / rt + 1))
+
+def read_marlin_table(num):
+    "Read the { raw, temperature } points of Marlin's thermistortable_num.h"
+    text = open(os.path.join(MARLIN, "thermistortable_%s.h" % num)).read()
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    text = re.sub(r'//.*', '', text)
+    points = []
+    for m in re.finditer(r'\{\s*OV\(\s*([-\d.]+)\s*\)\s*,\s*([-\d.]+)\s*\}|PtLine\(\s*([-\d.]+)\s*,\s*([-\d.]+)\s*,\s*([-\d.]+)\s*\)', text):
+        if m.group(1):
+            points.append((int(float(m.group(1)) * OVERSAMPLENR), int(m.group(2))))
+        else:
+            t = int(m.group(3))
+            points.append((pt_ad_val(t, float(m.group(4)), float(m.group(5))) * OVERSAMPLENR, t))
+    return points
+
+def scan_table(table, raw):
+    "Convert a raw value by bisecting the table, as SCAN_THERMISTOR_TABLE in temperature.cpp"
+    l, r = 0, len(table)
+    while True:
+        m = (l + r) >> 1
+        if m == l or m == r: return table[-1][1]
+        (v00, v01), (v10, v11) = table[m - 1], table[m]
+        if raw < v00: r = m
+        elif raw > v10: l = m
+        else: return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00)
+
+def uniform_table(table):
+    "Resample a table to one entry per ADC count, as UNIFORM_TEMPTABLE in thermistortables.h"
+    def temp(raw):
+        if raw <= table[0][0]: return table[0][1]
+        for (v00, v01), (v10, v11) in zip(table, table[1:]):
+            if raw <= v10: return v01 + (raw - v00) * float(v11 - v01) / float(v10 - v00)
+        return table[-1][1]
+    return [int(t * UNIFORM_SCALE - 0.5 if t < 0 else t * UNIFORM_SCALE + 0.5) for t in (temp(adc * OVERSAMPLENR) for adc in range(1025))]
+
+def uniform_celsius(utable, raw):
+    "Convert a raw value with a uniform table, as uniform_table_celsius in temperature.cpp"
+    i, f = divmod(min(raw, 1024 * OVERSAMPLENR - 1), OVERSAMPLENR)
+    return (utable[i] * OVERSAMPLENR + (utable[i + 1] - utable[i]) * f) / float(UNIFORM_SCALE * OVERSAMPLENR)
+
+def check_tables(which):
+    "Report the largest difference between the two conversions over each table's range"
+    if which == "all":
+        nums = sorted(int(re.findall(r'(\d+)\.h$', f)[0]) for f in glob.glob(os.path.join(MARLIN, "thermistortable_*.h")))
+    else:
+        nums = [int(which)]
+    print("// Table  Points  Max error  At raw (ADC)")
+    for num in nums:
+        table = read_marlin_table(num)
+        if len(table) < 2 or any(b[0] < a[0] for a, b in zip(table, table[1:])):
+            print("// %5d  not a fixed, increasing table" % num)
+            continue
+        utable = uniform_table(table)
+        err, at = 0, table[0][0]
+        for raw in range(table[0][0], min(table[-1][0], 1024 * OVERSAMPLENR - 1) + 1):
+            e = abs(uniform_celsius(utable, raw) - scan_table(table, raw))
+            if e > err: err, at = e, raw
+        print("// %5d  %6d  %6.3f degC  %d (%.2f)" % (num, len(table), err, at, at / float(OVERSAMPLENR)))
+
 def main(argv):
     "Default values"
     t1 = 25                                 # low temperature in Kelvin (25 degC)
@@ -95,9 +167,9 @@ def main(argv):
     num_temps = 36;                         # number of entries for look-up table
 
     try:
-        opts, args = getopt.getopt(argv, "h", ["help", "rp=", "t1=", "t2=", "t3=", "num-temps="])
+        opts, args = getopt.getopt(argv, "h", ["help", "rp=", "t1=", "t2=", "t3=", "num-temps=", "check="])
     except getopt.GetoptError as err:
-        print  str(err)
+        print(str(err))
         usage()
         sys.exit(2)
 
@@ -121,35 +193,38 @@ def main(argv):
             r3 = float(arg[1])
         elif opt == "--num-temps":
             num_temps = int(arg)
+        elif opt == "--check":
+            check_tables(arg)
+            sys.exit()
 
     t = Thermistor(rp, t1, r1, t2, r2, t3, r3)
     increment = int((ARES-1)/(num_temps-1));
-    step = (TMIN-TMAX) / (num_temps-1)
+    step = (TMIN-TMAX) // (num_temps-1)
     low_bound = t.temp(ARES-1);
     up_bound = t.temp(1);
     min_temp = int(TMIN if TMIN > low_bound else low_bound)
     max_temp = int(TMAX if TMAX < up_bound else up_bound)
     temps = range(max_temp, TMIN+step, step);
 
-    print "// Thermistor lookup table for Marlin"
-    print "// ./createTemperatureLookupMarlin.py --rp=%s --t1=%s:%s --t2=%s:%s --t3=%s:%s --num-temps=%s" % (rp, t1, r1, t2, r2, t3, r3, num_temps)
-    print "// Steinhart-Hart Coefficients: a=%.15g, b=%.15g, c=%.15g " % (t.c1, t.c2, t.c3)
-    print "// Theoretical limits of thermistor: %.2f to %.2f degC" % (low_bound, up_bound)
-    print
-    print "const short temptable[][2] PROGMEM = {"
+    print("// Thermistor lookup table for Marlin")
+    print("// ./createTemperatureLookupMarlin.py --rp=%s --t1=%s:%s --t2=%s:%s --t3=%s:%s --num-temps=%s" % (rp, t1, r1, t2, r2, t3, r3, num_temps))
+    print("// Steinhart-Hart Coefficients: a=%.15g, b=%.15g, c=%.15g " % (t.c1, t.c2, t.c3))
+    print("// Theoretical limits of thermistor: %.2f to %.2f degC" % (low_bound, up_bound))
+    print()
+    print("const short temptable[][2] PROGMEM = {")
 
     for temp in temps:
         adc = t.adc(temp)
-        print "    { OV(%7.2f), %4s }%s // v=%.3f\tr=%.3f\tres=%.3f degC/count" % (adc , temp, \
+        print("    { OV(%7.2f), %4s }%s // v=%.3f\tr=%.3f\tres=%.3f degC/count" % (adc , temp, \
                         ',' if temp != temps[-1] else ' ', \
                         t.voltage(adc), \
                         t.resist( adc), \
                         t.resol(  adc) \
-                    )
-    print "};"
+                    ))
+    print("};")
 
 def usage():
-    print __doc__
+    print(__doc__)
 
 if __name__ == "__main__":
     main(sys.argv[1:])